@@ -0,0 +1,148 @@
+/* Author:      Vincent Sevilla
+ * Filename:    BoundedQueue.h
+ * Description: Header file for the BoundedQueue class. A fixed capacity
+ *                queue that lets threads hand work to one another without
+ *                ever holding more than capacity items in memory.
+ */
+
+
+#ifndef _BOUNDEDQUEUE
+#define _BOUNDEDQUEUE
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+template <typename T>
+class BoundedQueue {
+  public:
+    explicit BoundedQueue(size_t capacity);
+    bool push(const T & item);
+    bool pop(T & item);
+    bool popBatch(std::vector<T> & batch, size_t maxItems);
+    void close();
+
+  private:
+    size_t capacity;
+    bool closed;
+    std::deque<T> items;
+    std::mutex lock;
+    /*signalled when an item is added or the queue is closed*/
+    std::condition_variable notEmpty;
+    /*signalled when an item is removed or the queue is closed*/
+    std::condition_variable notFull;
+};
+
+
+
+/* Constructor:     BoundedQueue
+ * Description:     Creates an open, empty queue holding at most capacity
+ *                  items.
+ */
+template <typename T>
+BoundedQueue<T>::BoundedQueue(size_t capacity) 
+    : capacity(capacity), closed(false) {
+}
+
+
+
+/*
+ * Name:        push
+ * Prototype:   push(const T & item);
+ * Description: This function adds an item to the back of the queue,
+ *                waiting while the queue is full.
+ * Parameters:
+ *    item        - The item to add
+ * Return:      true if the item was added, false if the queue was closed.
+ */
+template <typename T>
+bool BoundedQueue<T>::push(const T & item) {
+  std::unique_lock<std::mutex> guard(lock);
+
+  notFull.wait(guard, [this] { return closed || items.size() < capacity; });
+  if (closed) {
+    return false;
+  }
+
+  items.push_back(item);
+  notEmpty.notify_one();
+  return true;
+}
+
+
+
+/*
+ * Name:        pop
+ * Prototype:   pop(T & item);
+ * Description: This function removes the item at the front of the queue,
+ *                waiting while the queue is empty. Items still queued when
+ *                the queue is closed are handed out before it reports
+ *                that it is done.
+ * Parameters:
+ *    item        - Where to put the removed item
+ * Return:      true if an item was removed, false if the queue was closed
+ *              and is empty.
+ */
+template <typename T>
+bool BoundedQueue<T>::pop(T & item) {
+  std::unique_lock<std::mutex> guard(lock);
+
+  notEmpty.wait(guard, [this] { return closed || !items.empty(); });
+  if (items.empty()) {
+    return false;
+  }
+
+  item = items.front();
+  items.pop_front();
+  notFull.notify_one();
+  return true;
+}
+
+
+
+/*
+ * Name:        popBatch
+ * Prototype:   popBatch(std::vector<T> & batch, size_t maxItems);
+ * Description: This function waits like pop for at least one item, then
+ *                takes up to maxItems of what is queued in one go.
+ * Parameters:
+ *    batch       - Replaced with the removed items, oldest first
+ *    maxItems    - The most items to remove
+ * Return:      true if any items were removed, false if the queue was 
+ *              closed and is empty.
+ */
+template <typename T>
+bool BoundedQueue<T>::popBatch(std::vector<T> & batch, size_t maxItems) {
+  std::unique_lock<std::mutex> guard(lock);
+
+  batch.clear();
+  notEmpty.wait(guard, [this] { return closed || !items.empty(); });
+  while (!items.empty() && batch.size() < maxItems) {
+    batch.push_back(items.front());
+    items.pop_front();
+  }
+
+  notFull.notify_all();
+  return !batch.empty();
+}
+
+
+
+/*
+ * Name:        close
+ * Prototype:   close();
+ * Description: This function stops the queue from accepting items and
+ *                wakes every thread waiting on it.
+ */
+template <typename T>
+void BoundedQueue<T>::close() {
+  std::lock_guard<std::mutex> guard(lock);
+
+  closed = true;
+  notEmpty.notify_all();
+  notFull.notify_all();
+}
+
+
+#endif
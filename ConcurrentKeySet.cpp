@@ -0,0 +1,127 @@
+/* Author:      Vincent Sevilla
+ * Filename:    ConcurrentKeySet.cpp
+ * Description: Implementation file for the ConcurrentKeySet class.
+ *                Contains the code to add and look up the keys of sets.
+ */
+
+#include "ConcurrentKeySet.h"
+
+using namespace std;
+
+
+/* Constructor:     ConcurrentKeySet
+ * Description:     Starts every shard empty.
+ */
+ConcurrentKeySet::ConcurrentKeySet() {
+  for (int shard = 0; shard < KEY_SHARDS; shard++) {
+    used[shard] = 0;
+  }
+}
+
+
+
+/*
+ * Name:        insert
+ * Prototype:   insert(unsigned long long key);
+ * Description: This function adds a key to the set, doubling its shard's
+ *                table first if the table is KEY_TABLE_FILL quarters full.
+ * Parameters:
+ *    key         - The canonical key of a set of puzzle pieces
+ * Return:      true if the key is new, false if it was already there.
+ */
+bool ConcurrentKeySet::insert(unsigned long long key) {
+  int shard = (int)(key % KEY_SHARDS);
+  lock_guard<mutex> guard(locks[shard]);
+  vector<unsigned long long> & table = shards[shard];
+  size_t slot = 0;
+
+  if ((used[shard] + 1) * 4 > table.size() * KEY_TABLE_FILL) {
+    grow(table);
+  }
+
+  for (slot = slotFor(key, table.size()); table[slot]; 
+      slot = (slot + 1) & (table.size() - 1)) {
+    if (table[slot] == key) {
+      return false;
+    }
+  }
+
+  table[slot] = key;
+  used[shard]++;
+  return true;
+}
+
+
+
+/*
+ * Name:        contains
+ * Prototype:   contains(unsigned long long key);
+ * Description: This function checks if a key is already in the set.
+ * Parameters:
+ *    key         - The canonical key of a set of puzzle pieces
+ * Return:      true if the key is in the set, false if not.
+ */
+bool ConcurrentKeySet::contains(unsigned long long key) {
+  int shard = (int)(key % KEY_SHARDS);
+  lock_guard<mutex> guard(locks[shard]);
+  const vector<unsigned long long> & table = shards[shard];
+
+  if (table.empty()) {
+    return false;
+  }
+
+  for (size_t slot = slotFor(key, table.size()); table[slot]; 
+      slot = (slot + 1) & (table.size() - 1)) {
+    if (table[slot] == key) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+
+/*
+ * Name:        slotFor
+ * Prototype:   slotFor(unsigned long long key, size_t tableSize);
+ * Description: This function picks the slot a key's search starts at.
+ *                The low bits of a key already picked its shard, so the
+ *                key is mixed before the slot is taken from its high bits.
+ * Parameters:
+ *    key         - The canonical key of a set of puzzle pieces
+ *    tableSize   - The number of slots, a power of two
+ * Return:      The first slot to look in
+ */
+size_t ConcurrentKeySet::slotFor(unsigned long long key, size_t tableSize) {
+  return (size_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) & (tableSize - 1);
+}
+
+
+
+/*
+ * Name:        grow
+ * Prototype:   grow(vector<unsigned long long> & table);
+ * Description: This function doubles a shard's table, or gives an empty
+ *                one KEY_TABLE_START slots, and puts every key back.
+ * Parameters:
+ *    table       - The shard's table
+ */
+void ConcurrentKeySet::grow(vector<unsigned long long> & table) {
+
+  vector<unsigned long long> larger(table.empty() 
+      ? KEY_TABLE_START : table.size() * 2, 0);
+  size_t slot = 0;
+
+  for (size_t index = 0; index < table.size(); index++) {
+    if (!table[index]) {
+      continue;
+    }
+    for (slot = slotFor(table[index], larger.size()); larger[slot];
+        slot = (slot + 1) & (larger.size() - 1)) {
+    }
+    larger[slot] = table[index];
+  }
+
+  table.swap(larger);
+}
@@ -0,0 +1,49 @@
+/* Author:      Vincent Sevilla
+ * Filename:    ConcurrentKeySet.h
+ * Description: Header file for the ConcurrentKeySet class. Contains the
+ *                code that remembers which sets of puzzle pieces were
+ *                already produced, for the threads that produce unique
+ *                sets.
+ */
+
+
+#ifndef _CONCURRENTKEYSET
+#define _CONCURRENTKEYSET
+
+#include <mutex>
+#include <vector>
+#include <cstddef>
+
+const int KEY_SHARDS = 64;
+/*slots a key set shard starts with, and how full, in quarters, it may get
+  before it doubles*/
+const size_t KEY_TABLE_START = 256;
+const size_t KEY_TABLE_FILL = 3;
+
+/*how many sets in a row may be turned down before a producer of unique
+  sets gives up, for when no more sets can be accepted*/
+const long long STALL_ATTEMPTS = 200000;
+
+/*A set of canonical keys that many threads can add to at once. The keys
+  are spread over several independently locked shards, each a flat open
+  addressing table of the keys themselves, so a key costs 8 bytes times
+  the table's spare room rather than a hash node of its own. No set has
+  key 0, so 0 marks an empty slot*/
+class ConcurrentKeySet {
+  public:
+    ConcurrentKeySet();
+    bool insert(unsigned long long key);
+    bool contains(unsigned long long key);
+
+  private:
+    std::mutex locks[KEY_SHARDS];
+    std::vector<unsigned long long> shards[KEY_SHARDS];
+    size_t used[KEY_SHARDS];
+
+    static size_t slotFor(unsigned long long key, size_t tableSize);
+
+    static void grow(std::vector<unsigned long long> & table);
+};
+
+
+#endif
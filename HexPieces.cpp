@@ -6,11 +6,14 @@
 
 #include <iostream>
 #include "HexPieces.h"
+#include "PuzzleRecorder.h"
 #include <string>
 #include <fstream>
 #include <unistd.h>
 #include <cstdlib>
 #include <ctime>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 
@@ -18,9 +21,11 @@ using namespace std;
 /* Constructor:     HexPieces
  * Description:     Simply initializes the tiles on the board to be empty. 
  */
-HexPieces::HexPieces() {
+HexPieces::HexPieces() 
+    : recorder(nullptr), nodesVisited(0), orderingMode(ORDER_BY_INDEX) {
   for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
     tilesOnTheBoard[tileNumber] = -1;
+    solvedBoard[tileNumber] = -1;
   }
 }
 
@@ -42,6 +47,10 @@ bool HexPieces::isTheRandomSetSolvable(int randomSet[][COLSIZE],
  
   int solved = 0; int & temp = solved;
 
+  nodesVisited = 0;
+  if (orderingMode != ORDER_BY_INDEX) {
+    countEdgePairs(randomSet);
+  }
   solveIt(randomSet, displayFlag, temp, 0);  
 
   return (bool)solved;
@@ -55,8 +64,9 @@ bool HexPieces::isTheRandomSetSolvable(int randomSet[][COLSIZE],
  *                  int & solved, int currentState); 
  * Description: This function attempts to solve the hex puzzle.  It tries to
  *              do so recursively by exhaustively cycling through all 7 possible
- *              puzzle pieces, placing a tile into a position if the tile is not
- *              on the board and if it fits. Since this function implements
+ *              puzzle pieces, in the order orderThePieces picks, placing a
+ *              tile into a position if the tile is not on the board and if
+ *              it fits. Since this function implements
  *              recursion, the base case is if either the reference parameter 
  *              solved becomes true or if all 7 tiles have been placed in the
  *              center position, in which case the given set of puzzle pieces
@@ -74,12 +84,17 @@ void HexPieces::solveIt(int puzzlePieces[][COLSIZE], int displayFlag,
     int & solved, int currentState) {
 
   int currentPiece = -1, rotateCounter = 0, 
-      pieceIsOnTheBoard = 0, tileNumber = 0;
+      pieceIsOnTheBoard = 0, tileNumber = 0, orderIndex = -1, toTry = 0;
+  int order[ROWSIZE];
   bool shortCircuit = false;
 
+  toTry = orderThePieces(puzzlePieces, currentState, order);
+
   /*keep trying to solve until the puzzle has been solved or you've 
     already tried placing all the remaining tiles*/
-  while (!solved && ++currentPiece != ROWSIZE) {
+  while (!solved && ++orderIndex != toTry) {
+    currentPiece = orderingMode == ORDER_BY_INDEX 
+        ? orderIndex : order[orderIndex];
     shortCircuit = false;
     
     /*check to see if this tile is already on the board*/
@@ -94,6 +109,7 @@ void HexPieces::solveIt(int puzzlePieces[][COLSIZE], int displayFlag,
     if(!pieceIsOnTheBoard) {
 
       tilesOnTheBoard[currentState] = currentPiece;
+      nodesVisited++;
 
       /*If its not the center tile, and you havent rotated 6 times,
         and the border numbers do not match, then keep rotating-trying
@@ -148,6 +164,9 @@ void HexPieces::solveIt(int puzzlePieces[][COLSIZE], int displayFlag,
         /*see if we've filled all the slots on the board*/
         if (currentState == COLSIZE) { 
           /*if this point is reached then the puzzle has been solved*/
+          for (int tile = 0; tile < ROWSIZE; tile++) {
+            solvedBoard[tile] = tilesOnTheBoard[tile];
+          }
           solved = 1; tilesOnTheBoard[currentState] = -1;return;
         }
 
@@ -164,6 +183,135 @@ void HexPieces::solveIt(int puzzlePieces[][COLSIZE], int displayFlag,
 
 
 
+/*
+ * Name:        countEdgePairs
+ * Prototype:   countEdgePairs(int puzzlePieces[][COLSIZE]);
+ * Description: This function looks over the set once before solving it.
+ *              It counts how often each pair of border numbers sits side by
+ *              side, notes which numbers sit either side of each number on
+ *              every piece, and sorts the pieces so those whose pairs are
+ *              most common come first. Neighbours match a piece by sharing one
+ *              of its pairs, so a piece with common pairs is the likeliest
+ *              to lead to a solution. Trying rare pairs first was measured
+ *              to take more placements on solvable sets, not fewer.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ */
+void HexPieces::countEdgePairs(int puzzlePieces[][COLSIZE]) {
+
+  int score[ROWSIZE] = {0};
+
+  for (int first = 0; first <= COLSIZE; first++) {
+    for (int second = 0; second <= COLSIZE; second++) {
+      edgePairCount[first][second] = 0;
+    }
+  }
+
+  /*the numbers either side of each border number stay the same however
+    the piece is turned, so they are only worked out here*/
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      edgePairCount[puzzlePieces[tileNumber][borderNumber]]
+          [puzzlePieces[tileNumber][(borderNumber + 1) % COLSIZE]]++;
+      borderAfter[tileNumber][puzzlePieces[tileNumber][borderNumber]] =
+          puzzlePieces[tileNumber][(borderNumber + 1) % COLSIZE];
+      borderBefore[tileNumber][puzzlePieces[tileNumber][borderNumber]] =
+          puzzlePieces[tileNumber][(borderNumber + COLSIZE - 1) % COLSIZE];
+    }
+  }
+
+  /*a piece scores the number of times its own pairs occur in the set*/
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    staticOrder[tileNumber] = tileNumber;
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      score[tileNumber] += 
+          edgePairCount[puzzlePieces[tileNumber][borderNumber]]
+          [puzzlePieces[tileNumber][(borderNumber + 1) % COLSIZE]];
+    }
+  }
+
+  stable_sort(staticOrder, staticOrder + ROWSIZE, 
+      [&score](int first, int second) { 
+        return score[first] > score[second]; 
+      });
+}
+
+
+
+/*
+ * Name:        orderThePieces
+ * Prototype:   orderThePieces(int puzzlePieces[][COLSIZE], int currentState,
+ *                  int order[ROWSIZE]);
+ * Description: This function picks the pieces solveIt tries for the given
+ *              position, and the order it tries them in. ORDER_BY_INDEX
+ *              leaves order alone, since solveIt then tries pieces 0-6 by
+ *              their index. ORDER_STATIC uses the order countEdgePairs
+ *              found. ORDER_DYNAMIC starts from that order and, on a ring
+ *              tile, keeps only the pieces that have the two border numbers
+ *              the tile needs next to each other: the one on the center
+ *              tile's touching edge, then the one on the previous ring
+ *              tile's touching edge. Of those, pieces showing the next ring
+ *              tile the pair the most pieces have come first.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ *    currentState      - Determines how many tiles have been placed on the
+ *                          board depending on the current level of recursion.
+ *    order             - Where to write the pieces to try
+ * Return:      How many pieces of order solveIt should try
+ */
+int HexPieces::orderThePieces(int puzzlePieces[][COLSIZE], int currentState,
+    int order[ROWSIZE]) {
+
+  int rank[ROWSIZE] = {0};
+  int direction = currentState - 1, centerTile = tilesOnTheBoard[0];
+  int needed = 0, previous = 0, nextNeeded = 0, lastNeeded = 0;
+  int candidates = 0, piece = 0, slot = 0;
+
+  if (orderingMode == ORDER_BY_INDEX) {
+    return ROWSIZE;
+  }
+
+  if (orderingMode != ORDER_DYNAMIC || !currentState) {
+    for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+      order[tileNumber] = staticOrder[tileNumber];
+    }
+    return ROWSIZE;
+  }
+
+  /*the numbers this ring tile must show the center and the tile before it,
+    and the number the next ring tile must show the center. The last ring
+    tile must also show the first ring tile its number*/
+  needed = puzzlePieces[centerTile][direction];
+  previous = direction 
+      ? puzzlePieces[tilesOnTheBoard[direction]][(direction + 1) % COLSIZE] 
+      : 0;
+  nextNeeded = puzzlePieces[centerTile][(direction + 1) % COLSIZE];
+  lastNeeded = direction == COLSIZE - 1 
+      ? puzzlePieces[tilesOnTheBoard[1]][4] : 0;
+
+  /*pieces that cannot fit are left out, and the rest go in by how many
+    pieces they leave the next ring tile to match, most first*/
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    piece = staticOrder[tileNumber];
+    if ((previous && borderAfter[piece][needed] != previous) ||
+        (lastNeeded && borderBefore[piece][needed] != lastNeeded)) {
+      continue;
+    }
+
+    rank[piece] = edgePairCount[nextNeeded][borderBefore[piece][needed]];
+    for (slot = candidates; slot > 0 && rank[order[slot - 1]] < rank[piece];
+        slot--) {
+      order[slot] = order[slot - 1];
+    }
+    order[slot] = piece;
+    candidates++;
+  }
+
+  return candidates;
+}
+
+
+
 /*
  * Name:        checkForDuplicates 
  * Prototype:   checkForDuplicates(int puzzlePieces[][COLSIZE], 
@@ -444,6 +592,40 @@ void HexPieces::generateARandomSet(int puzzlePieces[][COLSIZE]) {
 
 
 
+/*
+ * Name:        generateARandomSet 
+ * Prototype:   generateARandomSet(int puzzlePieces[][COLSIZE],
+ *                  mt19937 & generator); 
+ * Description: This function generates a random set of puzzle pieces from
+ *                the given generator instead of reseeding rand(), so many
+ *                threads can each draw sets from their own generator. Every
+ *                tile is a shuffle of the border numbers 1-6, and tiles that
+ *                repeat an earlier tile's sequence are drawn again.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ *    generator         - The random number generator to draw from
+ */
+void HexPieces::generateARandomSet(int puzzlePieces[][COLSIZE], 
+    mt19937 & generator) {
+
+  /*for all 7 possible tiles*/
+  for (int row = 0; row < ROWSIZE; row++) {
+
+    /*a tile with no repeated border numbers is a shuffle of 1-6*/
+    for (int column = 0; column < COLSIZE; column++) {
+      puzzlePieces[row][column] = column + 1;
+    }
+    shuffle(puzzlePieces[row], puzzlePieces[row] + COLSIZE, generator);
+
+    /*try this tile again if it matches one we've generated b4 this one*/
+    if (row > 0 && arePiecesTheSame(puzzlePieces, row)) {
+      row--;
+    }
+  }
+}
+
+
+
 /*
  * Name:        displayASet
  * Prototype:   displayASet(int puzzlePieces[][COLSIZE]);
@@ -500,65 +682,199 @@ string HexPieces::translateTheTilesToString(int puzzlePieces[][COLSIZE],
 
 
 
+/*The lines of every template file, and whether every one of them could be
+  read and had something in it*/
+struct TemplateCache {
+  vector<string> lines[ROWSIZE + 1];
+  bool loaded;
+
+  TemplateCache() : loaded(true) {
+    string tempString = "";
+    ifstream templateFile;
+
+    /*template_0.txt holds the board with 1 tile, and so on*/
+    for (int state = 1; state <= ROWSIZE; state++) {
+      templateFile.open("templates/template_" + to_string(state - 1) + 
+          ".txt", ios::in);
+      if (!templateFile.is_open() || 
+          templateFile.peek() == ifstream::traits_type::eof()) {
+        loaded = false;
+      }
+
+      while (templateFile.is_open() && !templateFile.eof()) {
+        getline(templateFile, tempString);
+        lines[state].push_back(tempString);
+      }
+
+      templateFile.close();
+      templateFile.clear();
+    }
+  }
+};
+
+
+
 /*
- * Name:        displayThePicture
- * Prototype:   displayThePicture(int puzzlePieces[][COLSIZE],int currentState);
- * Description: This function is designed to display the current state of
- *              the puzzle board to the console depending on how many
- *              pieces are on the board.
+ * Name:        templateCache
+ * Prototype:   templateCache();
+ * Description: This function hands back the template files. They are read
+ *              the first time this is called, safely even if several
+ *              threads get here at once, and kept from then on.
+ * Return:      The lines of every template file
+ */
+static const TemplateCache & templateCache() {
+  static const TemplateCache cache;
+
+  return cache;
+}
+
+
+
+/*
+ * Name:        templateLines
+ * Prototype:   templateLines(int currentState);
+ * Description: This function hands back the lines of the template file
+ *              for the given number of tiles on the board.
+ * Parameters:
+ *    currentState  - indicates how many tiles are currently on the board
+ * Return:      The lines of the matching template file
+ */
+static const vector<string> & templateLines(int currentState) {
+  return templateCache().lines[currentState >= 0 && 
+      currentState <= ROWSIZE ? currentState : 0];
+}
+
+
+
+/*
+ * Name:        loadTheTemplates
+ * Prototype:   loadTheTemplates();
+ * Description: This function reads the template files if they have not
+ *              been read yet, so that a missing file is found before any
+ *              board is drawn rather than drawn as an empty board.
+ * Return:      true if every template file could be read, false if not.
+ */
+bool HexPieces::loadTheTemplates() {
+  return templateCache().loaded;
+}
+
+
+
+/*
+ * Name:        renderThePicture
+ * Prototype:   renderThePicture(int puzzlePieces[][COLSIZE],
+ *                  int currentState);
+ * Description: This function draws the current state of the puzzle board
+ *              into a string depending on how many pieces are on the board.
  * Parameters:
  *    puzzlePieces  - the current set of puzzle pieces.
  *
  *    currentState  - indicates how many tiles are currently on the board
+ * Return:      The drawing of the board, one template line per line
  */
-void HexPieces::displayThePicture(int puzzlePieces[][COLSIZE],int currentState){
-	
-  string tempString = "", encodedTiles = "";
-  int stringLength = 0;
-
-  ifstream templateFile;
+string HexPieces::renderThePicture(int puzzlePieces[][COLSIZE], 
+    int currentState) {
 
+  string picture = "", encodedTiles = "";
+  const vector<string> & lines = templateLines(currentState);
 
   /*make a string representing all the tiles*/
   encodedTiles = translateTheTilesToString(puzzlePieces,
       currentState); 
 
-  /*open the correct file given the currentState of the board*/
-  if (currentState == 1) {
-    templateFile.open("templates/template_0.txt", ios::in);
-  }
-  else if (currentState == 2) {
-    templateFile.open("templates/template_1.txt", ios::in);
-  }
-  else if (currentState == 3) {
-    templateFile.open("templates/template_2.txt", ios::in);
+  /*fill in every line of the template with the correct numbers in place of
+    the placeholders*/
+  for (size_t line = 0; line < lines.size(); line++) {
+    picture += writeALine(lines[line], encodedTiles);
+    picture += "\n";
   }
-  else if (currentState == 4) {
-    templateFile.open("templates/template_3.txt", ios::in);
+
+  return picture;
+}
+
+
+
+/*
+ * Name:        renderTheSolution
+ * Prototype:   renderTheSolution(int puzzlePieces[][COLSIZE]);
+ * Description: This function draws the full board found by the last 
+ *              successful call to isTheRandomSetSolvable. The pieces must
+ *              still be turned the way that call left them.
+ * Parameters:
+ *    puzzlePieces  - the set of puzzle pieces that was solved.
+ * Return:      The drawing of the solved board
+ */
+string HexPieces::renderTheSolution(int puzzlePieces[][COLSIZE]) {
+
+  string picture = "";
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    tilesOnTheBoard[tileNumber] = solvedBoard[tileNumber];
   }
-  else if (currentState == 5) {
-    templateFile.open("templates/template_4.txt", ios::in);
+
+  picture = renderThePicture(puzzlePieces, ROWSIZE);
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    tilesOnTheBoard[tileNumber] = -1;
   }
-  else if (currentState == 6) {
-    templateFile.open("templates/template_5.txt", ios::in);
+
+  return picture;
+}
+
+
+
+/*
+ * Name:        copyTheSolution
+ * Prototype:   copyTheSolution(int puzzlePieces[][COLSIZE], 
+ *                  int solution[][COLSIZE]);
+ * Description: This function writes out the board found by the last
+ *              successful call to isTheRandomSetSolvable, one piece per 
+ *              tile in the same order as tilesOnTheBoard. The pieces must
+ *              still be turned the way that call left them.
+ * Parameters:
+ *    puzzlePieces  - the set of puzzle pieces that was solved.
+ *    solution      - where to write the center piece, then the north
+ *                      piece, then the northeast piece, etc.
+ */
+void HexPieces::copyTheSolution(int puzzlePieces[][COLSIZE], 
+    int solution[][COLSIZE]) {
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      solution[tileNumber][borderNumber] = 
+          puzzlePieces[solvedBoard[tileNumber]][borderNumber];
+    }
   }
-  else if (currentState == 7) {
-    templateFile.open("templates/template_6.txt", ios::in);
+}
+
+
+
+/*
+ * Name:        displayThePicture
+ * Prototype:   displayThePicture(int puzzlePieces[][COLSIZE],int currentState);
+ * Description: This function is designed to display the current state of
+ *              the puzzle board to the console depending on how many
+ *              pieces are on the board. If a recorder is attached, the 
+ *              frame is handed to it instead, without clearing the console
+ *              or pausing.
+ * Parameters:
+ *    puzzlePieces  - the current set of puzzle pieces.
+ *
+ *    currentState  - indicates how many tiles are currently on the board
+ */
+void HexPieces::displayThePicture(int puzzlePieces[][COLSIZE],int currentState){
+	
+  string picture = renderThePicture(puzzlePieces, currentState);
+
+  if (recorder) {
+    recorder->addFrame(picture);
+    return;
   }
-     
+
   /*clear the console so you can display the rotations frame by frame*/
   system("clear");
 
-  /*read a line from the template file and write it out w/ the correct
-    numbers in place of the placeholders to stdout. Keep doing this until
-    you've finished scanning the whole file*/
-  while (!templateFile.eof()) {
-    getline(templateFile, tempString);
-    writeALine(tempString, encodedTiles);
-  }
-
-  /*close file*/
-  templateFile.close();
+  cout << picture << flush;
   
   /*pause the frame for the desired amount of time*/
   usleep(frameTime);
@@ -570,8 +886,7 @@ void HexPieces::displayThePicture(int puzzlePieces[][COLSIZE],int currentState){
  * Name:        writeALine
  * Prototype:   writeALine(string lineFromTemplateFile, string encodedTiles); 
  * Description: It replaces placeholders in a given string
- *                  w/ the correct tile numbers/bordernumbers and
- *                  then prints this updated string to stdout.
+ *                  w/ the correct tile numbers/bordernumbers.
  * Parameters:
  *    lineFromTemplateFile  - This is a line from a specific
  *        hex puzzle template file.  It has placeholders that 
@@ -584,7 +899,7 @@ void HexPieces::displayThePicture(int puzzlePieces[][COLSIZE],int currentState){
  *        bordernumbers from every tile in a specific order.  Every
  *        7th number in this string is the tile number (0-6).
  */
-void HexPieces::writeALine(string lineFromTemplateFile,
+string HexPieces::writeALine(string lineFromTemplateFile,
     string encodedTiles) {
 	
   char tempChar;
@@ -609,8 +924,8 @@ void HexPieces::writeALine(string lineFromTemplateFile,
     }
   }
 
-	/* write the updated line from the template file to stdout*/
-  cout << lineFromTemplateFile << endl;
+  /*hand back the updated line from the template file*/
+  return lineFromTemplateFile;
 }
 
 
@@ -8,25 +8,62 @@
 #ifndef _HEXPIECES
 #define _HEXPIECES
 
+#include <string>
+#include <random>
+
 const int ROWSIZE = 7;
 const int COLSIZE = 6;
 const int ONE_SECOND = 1000000;
 const int NUM_OF_ARGS = 2;
+/*the orders solveIt can try pieces in, and their names on the command
+  line*/
+const int ORDER_BY_INDEX = 0;
+const int ORDER_STATIC = 1;
+const int ORDER_DYNAMIC = 2;
+const int NUM_OF_ORDERINGS = 3;
+const std::string ORDERING_NAMES[NUM_OF_ORDERINGS] = 
+    {"index", "static", "dynamic"};
+const std::string ORDERING_FLAG = "--ordering";
+const int NUM_OF_ORDERING_ARGS = 3;
+const std::string ORDERING_USAGE = "To compare the orders the solver can " \
+    "try pieces in, please type in: ./hexexe --ordering 100000\n" \
+    "to solve the same 100000 random sets in every order and report how " \
+    "many pieces each placed on average and how long each took. An " \
+    "optional last argument sets the number of threads to use.\n";
 const std::string USAGE_PROMPT = "To run, please type in: ./hexexe 1\n" \
     "to indicate a display frame time of 1 second.\n" \
     "Feel free to change this value anywhere between " \
-    "0 - 5 seconds.\n";
+    "0 - 5 seconds. An optional second argument of index, static or " \
+    "dynamic picks the order pieces are tried in.\n";
 const std:: string USAGE_ERR = "Please only real numbers for your input!\n\n";
+const std::string TEMPLATE_ERR = "Could not read the board templates. " \
+    "Please run from the directory that holds the templates folder.\n";
+
+class PuzzleRecorder;
 
 class HexPieces {
   public:
     /*time in seconds of how long to display the board for one frame*/
     int frameTime;
+    /*if set, frames go to this recorder instead of the console*/
+    PuzzleRecorder * recorder;
+    /*number of times solveIt placed a piece during the last solve*/
+    long long nodesVisited;
+    /*which order solveIt tries pieces in, ORDER_BY_INDEX by default*/
+    int orderingMode;
     
     HexPieces();
     bool isTheRandomSetSolvable(int randomSet[][COLSIZE], int displayFlag);
     void generateARandomSet(int puzzlePieces[][COLSIZE]);
+    void generateARandomSet(int puzzlePieces[][COLSIZE], 
+        std::mt19937 & generator);
     void displayASet(int puzzlePieces[][COLSIZE]);
+    std::string renderThePicture(int puzzlePieces[][COLSIZE], 
+        int currentState);
+    std::string renderTheSolution(int puzzlePieces[][COLSIZE]);
+    void copyTheSolution(int puzzlePieces[][COLSIZE], 
+        int solution[][COLSIZE]);
+    bool loadTheTemplates();
 
   private:
     /*Represents which tiles are on the board:
@@ -34,10 +71,27 @@ class HexPieces {
       element 1 = piece currently on north tile,
       element 2 = piece currently on northeast tile, etc...*/
     int tilesOnTheBoard[ROWSIZE];
+    /*tilesOnTheBoard as it was when the last solve succeeded*/
+    int solvedBoard[ROWSIZE];
+
+    /*how often each border number follows each other one clockwise, over
+      every piece in the set being solved, and the pieces sorted so those
+      whose own pairs are most common come first*/
+    int edgePairCount[COLSIZE + 1][COLSIZE + 1];
+    int staticOrder[ROWSIZE];
+    /*for each piece, the border number just after and just before each of
+      its border numbers going clockwise*/
+    int borderAfter[ROWSIZE][COLSIZE + 1];
+    int borderBefore[ROWSIZE][COLSIZE + 1];
 
     void solveIt(int puzzlePieces[][COLSIZE], int displayFlag, int & solved, 
         int currentState);
 
+    void countEdgePairs(int puzzlePieces[][COLSIZE]);
+
+    int orderThePieces(int puzzlePieces[][COLSIZE], int currentState,
+        int order[ROWSIZE]);
+
     bool checkForDuplicates(int puzzlePieces[][COLSIZE], int currentState); 
     
     bool youCanShortCircuit(int currentState, int puzzlePieces[][COLSIZE]);
@@ -49,7 +103,8 @@ class HexPieces {
 
     void displayThePicture(int puzzlePieces[][COLSIZE], int currentState);
 
-    void writeALine(std::string lineFromTemplateFile, std::string encodedTiles);
+    std::string writeALine(std::string lineFromTemplateFile, 
+        std::string encodedTiles);
 
     bool arePiecesTheSame(int puzzlePieces[][COLSIZE], int tileNumber);
 
@@ -0,0 +1,346 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PieceSets.cpp
+ * Description: Implementation file for the piece set helpers. Contains
+ *                the code to name puzzle pieces and sets of puzzle pieces
+ *                independently of how they are rotated or ordered.
+ */
+
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include "PieceSets.h"
+
+using namespace std;
+
+
+/*Pascal's triangle for the piece classes and set sizes used when ranking
+  sets*/
+struct BinomialTable {
+  long long values[NUM_OF_CLASSES + 1][ROWSIZE + 1];
+
+  BinomialTable() {
+    for (int row = 0; row <= NUM_OF_CLASSES; row++) {
+      values[row][0] = 1;
+      for (int col = 1; col <= ROWSIZE; col++) {
+        values[row][col] = row ? values[row - 1][col - 1] + 
+            values[row - 1][col] : 0;
+      }
+    }
+  }
+};
+
+
+
+/*
+ * Name:        choose
+ * Prototype:   choose(int n, int k);
+ * Description: This function looks up n choose k. The table is built the
+ *                first time it is needed, safely even if several threads
+ *                get here at once.
+ * Parameters:
+ *    n           - The number of things to choose from, 0-120
+ *    k           - The number of things chosen, 0-7
+ * Return:      n choose k
+ */
+static long long choose(int n, int k) {
+  static const BinomialTable table;
+
+  return table.values[n][k];
+}
+
+
+
+const long long NUM_OF_SETS = choose(NUM_OF_CLASSES, ROWSIZE);
+
+
+
+/*
+ * Name:        pieceClass
+ * Prototype:   pieceClass(const int puzzlePiece[COLSIZE]);
+ * Description: This function numbers a puzzle piece from 0-119 so that all
+ *                6 rotations of the piece get the same number. Since a
+ *                piece never repeats a border number, it is a rotation of
+ *                1 followed by some ordering of 2-6, and that ordering is
+ *                numbered by its position in lexicographic order.
+ * Parameters:
+ *    puzzlePiece       - The 6 border numbers of the piece
+ * Return:      The class number of the piece, 0-119.
+ */
+int pieceClass(const int puzzlePiece[COLSIZE]) {
+
+  int start = 0, classNumber = 0, smaller = 0;
+  bool used[COLSIZE + 1] = {false};
+
+  /*find where the border number 1 sits*/
+  while (puzzlePiece[start] != 1) {
+    start++;
+  }
+
+  /*number the border numbers following 1 in clockwise order*/
+  for (int offset = 1; offset < COLSIZE; offset++) {
+    int borderNumber = puzzlePiece[(start + offset) % COLSIZE];
+
+    /*count the unused numbers that are smaller than this one*/
+    smaller = 0;
+    for (int value = 2; value < borderNumber; value++) {
+      if (!used[value]) {
+        smaller++;
+      }
+    }
+
+    used[borderNumber] = true;
+    classNumber = classNumber * (COLSIZE - offset) + smaller;
+  }
+
+  return classNumber;
+}
+
+
+
+/*
+ * Name:        pieceFromClass
+ * Prototype:   pieceFromClass(int classNumber, int puzzlePiece[COLSIZE]);
+ * Description: This function is the reverse of pieceClass. It writes out
+ *                the rotation of the piece that starts with border number 1.
+ * Parameters:
+ *    classNumber       - The class number of the piece, 0-119
+ *    puzzlePiece       - Where to write the 6 border numbers
+ */
+void pieceFromClass(int classNumber, int puzzlePiece[COLSIZE]) {
+
+  int digits[COLSIZE] = {0};
+  bool used[COLSIZE + 1] = {false};
+
+  /*peel off the digits, last (smallest radix) first*/
+  for (int offset = COLSIZE - 1; offset > 0; offset--) {
+    digits[offset] = classNumber % (COLSIZE - offset);
+    classNumber /= (COLSIZE - offset);
+  }
+
+  puzzlePiece[0] = 1;
+
+  /*each digit picks that many unused numbers to skip over*/
+  for (int offset = 1; offset < COLSIZE; offset++) {
+    int skip = digits[offset];
+    for (int value = 2; value <= COLSIZE; value++) {
+      if (!used[value] && skip-- == 0) {
+        used[value] = true;
+        puzzlePiece[offset] = value;
+        break;
+      }
+    }
+  }
+}
+
+
+
+/*
+ * Name:        setClasses
+ * Prototype:   setClasses(int puzzlePieces[][COLSIZE], int classes[ROWSIZE]);
+ * Description: This function finds the class of every piece in a set and
+ *                sorts them, so the result no longer depends on the order
+ *                or rotation of the pieces.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ *    classes           - Where to write the 7 sorted class numbers
+ */
+void setClasses(int puzzlePieces[][COLSIZE], int classes[ROWSIZE]) {
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    classes[tileNumber] = pieceClass(puzzlePieces[tileNumber]);
+  }
+
+  sort(classes, classes + ROWSIZE);
+}
+
+
+
+/*
+ * Name:        canonicalKey
+ * Prototype:   canonicalKey(int puzzlePieces[][COLSIZE]);
+ * Description: This function packs the sorted piece classes of a set into
+ *                one number. Two sets get the same key exactly when
+ *                arePiecesTheSame would pair up every piece of one with a
+ *                piece of the other.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ * Return:      The key for the set
+ */
+unsigned long long canonicalKey(int puzzlePieces[][COLSIZE]) {
+
+  int classes[ROWSIZE];
+  unsigned long long key = 0;
+
+  setClasses(puzzlePieces, classes);
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    key = (key << CLASS_BITS) | (unsigned long long)classes[tileNumber];
+  }
+
+  return key;
+}
+
+
+
+/*
+ * Name:        setToString
+ * Prototype:   setToString(int puzzlePieces[][COLSIZE]);
+ * Description: This function writes out a set of puzzle pieces the same
+ *                way displayASet does, followed by a blank line, so sets
+ *                can be streamed to a file one after another.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ * Return:      The formatted set
+ */
+string setToString(int puzzlePieces[][COLSIZE]) {
+
+  ostringstream formedString;
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      formedString << puzzlePieces[tileNumber][borderNumber] << " ";
+    }
+    formedString << "\n";
+  }
+  formedString << "\n";
+
+  return formedString.str();
+}
+
+
+
+/*
+ * Name:        isAValidSet
+ * Prototype:   isAValidSet(int puzzlePieces[][COLSIZE]);
+ * Description: This function checks that every piece uses each border
+ *                number 1-6 exactly once and that no two pieces have the
+ *                same sequence, the same rules generateARandomSet follows.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ * Return:      true if the set follows the rules, false if not.
+ */
+bool isAValidSet(int puzzlePieces[][COLSIZE]) {
+
+  int classes[ROWSIZE];
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    bool used[COLSIZE + 1] = {false};
+
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      int value = puzzlePieces[tileNumber][borderNumber];
+      if (value < 1 || value > COLSIZE || used[value]) {
+        return false;
+      }
+      used[value] = true;
+    }
+  }
+
+  /*sorted classes of distinct pieces never repeat*/
+  setClasses(puzzlePieces, classes);
+  return adjacent_find(classes, classes + ROWSIZE) == classes + ROWSIZE;
+}
+
+
+
+/*
+ * Name:        readASet
+ * Prototype:   readASet(istream & in, int puzzlePieces[][COLSIZE]);
+ * Description: This function reads one set of puzzle pieces written by
+ *                setToString or displayASet.
+ * Parameters:
+ *    in                - Where to read the set from
+ *    puzzlePieces      - Where to put the set
+ * Return:      SET_READ if a valid set was read, NO_MORE_SETS if only
+ *              whitespace was left, or BAD_SET if the input ran out part
+ *              way through a set, held something other than a number, or
+ *              the set breaks the rules.
+ */
+int readASet(istream & in, int puzzlePieces[][COLSIZE]) {
+
+  /*a clean end is only possible before the first number of a set*/
+  if ((in >> ws).eof()) {
+    return NO_MORE_SETS;
+  }
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      if (!(in >> puzzlePieces[tileNumber][borderNumber])) {
+        return BAD_SET;
+      }
+    }
+  }
+
+  return isAValidSet(puzzlePieces) ? SET_READ : BAD_SET;
+}
+
+
+
+/*
+ * Name:        rankASet
+ * Prototype:   rankASet(int puzzlePieces[][COLSIZE]);
+ * Description: This function numbers a set of puzzle pieces from 0 up to
+ *                NUM_OF_SETS - 1 using the combinatorial number system on
+ *                its sorted piece classes. Sets that differ only by the
+ *                rotation or order of their pieces get the same number.
+ * Parameters:
+ *    puzzlePieces      - The current set of puzzle pieces
+ * Return:      The rank of the set
+ */
+long long rankASet(int puzzlePieces[][COLSIZE]) {
+
+  int classes[ROWSIZE];
+  long long rank = 0;
+
+  setClasses(puzzlePieces, classes);
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    rank += choose(classes[tileNumber], tileNumber + 1);
+  }
+
+  return rank;
+}
+
+
+
+/*
+ * Name:        unrankASet
+ * Prototype:   unrankASet(long long rank, int puzzlePieces[][COLSIZE]);
+ * Description: This function is the reverse of rankASet. It writes out the
+ *                set with the given rank, every piece starting with border
+ *                number 1 and the pieces in increasing class order.
+ * Parameters:
+ *    rank              - The rank of the set, 0 to NUM_OF_SETS - 1
+ *    puzzlePieces      - Where to write the set of puzzle pieces
+ */
+void unrankASet(long long rank, int puzzlePieces[][COLSIZE]) {
+
+  int classNumber = NUM_OF_CLASSES;
+
+  /*the largest class is picked first, then each smaller one in turn*/
+  for (int tileNumber = ROWSIZE - 1; tileNumber >= 0; tileNumber--) {
+    do {
+      classNumber--;
+    } while (choose(classNumber, tileNumber + 1) > rank);
+
+    rank -= choose(classNumber, tileNumber + 1);
+    pieceFromClass(classNumber, puzzlePieces[tileNumber]);
+  }
+}
+
+
+
+/*
+ * Name:        sampleASet
+ * Prototype:   sampleASet(mt19937_64 & generator, 
+ *                  int puzzlePieces[][COLSIZE]);
+ * Description: This function picks a set by drawing a rank uniformly from
+ *                every rank there is, so each set of 7 distinct pieces is
+ *                equally likely.
+ * Parameters:
+ *    generator         - The random number generator to draw from
+ *    puzzlePieces      - Where to write the set of puzzle pieces
+ */
+void sampleASet(mt19937_64 & generator, int puzzlePieces[][COLSIZE]) {
+  uniform_int_distribution<long long> ranks(0, NUM_OF_SETS - 1);
+
+  unrankASet(ranks(generator), puzzlePieces);
+}
@@ -0,0 +1,58 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PieceSets.h
+ * Description: Header file for the piece set helpers. Contains the code
+ *                that identifies a puzzle piece or a whole set of puzzle
+ *                pieces regardless of rotation and order.
+ */
+
+
+#ifndef _PIECESETS
+#define _PIECESETS
+
+#include <iostream>
+#include <string>
+#include <random>
+#include "HexPieces.h"
+
+/*number of distinct pieces once rotations are ignored (5!)*/
+const int NUM_OF_CLASSES = 120;
+/*bits needed to hold one piece class inside a set key*/
+const int CLASS_BITS = 7;
+
+/*number of sets of 7 distinct piece classes, 120 choose 7. It is worked
+  out from the same table rankASet uses, so the two always agree*/
+extern const long long NUM_OF_SETS;
+
+/*what readASet found: a valid set, nothing but whitespace left, or
+  something that is not a valid set*/
+const int SET_READ = 0;
+const int NO_MORE_SETS = 1;
+const int BAD_SET = 2;
+
+/*A set of puzzle pieces that can be copied and queued by value*/
+struct PieceSet {
+  int pieces[ROWSIZE][COLSIZE];
+};
+
+int pieceClass(const int puzzlePiece[COLSIZE]);
+
+void pieceFromClass(int classNumber, int puzzlePiece[COLSIZE]);
+
+void setClasses(int puzzlePieces[][COLSIZE], int classes[ROWSIZE]);
+
+unsigned long long canonicalKey(int puzzlePieces[][COLSIZE]);
+
+std::string setToString(int puzzlePieces[][COLSIZE]);
+
+bool isAValidSet(int puzzlePieces[][COLSIZE]);
+
+int readASet(std::istream & in, int puzzlePieces[][COLSIZE]);
+
+long long rankASet(int puzzlePieces[][COLSIZE]);
+
+void unrankASet(long long rank, int puzzlePieces[][COLSIZE]);
+
+void sampleASet(std::mt19937_64 & generator, int puzzlePieces[][COLSIZE]);
+
+
+#endif
@@ -0,0 +1,197 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleCensus.cpp
+ * Description: Implementation file for the PuzzleCensus class. Contains
+ *                the code to count solvable sets by rank and to combine the
+ *                counts of several shards.
+ */
+
+#include <string>
+#include <thread>
+#include <algorithm>
+#include "PuzzleCensus.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleCensus
+ * Description:     Remembers how many threads to count with.
+ */
+PuzzleCensus::PuzzleCensus(int threadCount) 
+    : threadCount(threadCount > 0 ? threadCount : 1), nextRank(0), 
+      lastRank(0), solvableCount(0) {
+}
+
+
+
+/*
+ * Name:        countRange
+ * Prototype:   countRange(long long first, long long last);
+ * Description: This function solves every set with a rank in 
+ *                [first, last) and counts how many are solvable. Threads
+ *                take the range CENSUS_CHUNK ranks at a time.
+ * Parameters:
+ *    first       - The first rank to count
+ *    last        - One past the last rank to count
+ * Return:      The counts for the range
+ */
+CensusResult PuzzleCensus::countRange(long long first, long long last) {
+
+  vector<thread> workers;
+  CensusResult result;
+
+  nextRank = first;
+  lastRank = last;
+  solvableCount = 0;
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers.push_back(thread(&PuzzleCensus::countChunks, this));
+  }
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+
+  result.first = first;
+  result.last = last;
+  result.sets = last - first;
+  result.solvable = solvableCount;
+  return result;
+}
+
+
+
+/*
+ * Name:        countChunks
+ * Prototype:   countChunks();
+ * Description: This function keeps taking chunks of ranks and solving the
+ *                sets in them until the range runs out.
+ */
+void PuzzleCensus::countChunks() {
+
+  HexPieces censusPuzzle;
+  int possibleSet[ROWSIZE][COLSIZE];
+  long long solvable = 0, chunkStart = 0, chunkEnd = 0;
+
+  while ((chunkStart = nextRank.fetch_add(CENSUS_CHUNK)) < lastRank) {
+    chunkEnd = min(chunkStart + CENSUS_CHUNK, lastRank);
+
+    for (long long rank = chunkStart; rank < chunkEnd; rank++) {
+      unrankASet(rank, possibleSet);
+      if (censusPuzzle.isTheRandomSetSolvable(possibleSet, 0)) {
+        solvable++;
+      }
+    }
+  }
+
+  solvableCount += solvable;
+}
+
+
+
+/*
+ * Name:        shardRange
+ * Prototype:   shardRange(int shard, int shardCount, long long & first,
+ *                  long long & last);
+ * Description: This function splits all NUM_OF_SETS ranks into shardCount
+ *                contiguous ranges, which differ in size by at most one,
+ *                and finds the range of the given shard.
+ * Parameters:
+ *    shard       - Which shard, 0 to shardCount - 1
+ *    shardCount  - How many shards there are
+ *    first       - Set to the first rank of the shard
+ *    last        - Set to one past the last rank of the shard
+ */
+void PuzzleCensus::shardRange(int shard, int shardCount, long long & first,
+    long long & last) {
+
+  long long shardSize = NUM_OF_SETS / shardCount;
+  long long leftOver = NUM_OF_SETS % shardCount;
+
+  /*the first leftOver shards take one extra rank each*/
+  first = shard * shardSize + min((long long)shard, leftOver);
+  last = first + shardSize + (shard < leftOver ? 1 : 0);
+}
+
+
+
+/*
+ * Name:        writeResult
+ * Prototype:   writeResult(const CensusResult & result, ostream & out);
+ * Description: This function writes the counts for a range to a result
+ *                file.
+ * Parameters:
+ *    result      - The counts to write
+ *    out         - Where to write them
+ */
+void PuzzleCensus::writeResult(const CensusResult & result, ostream & out) {
+  out << CENSUS_HEADER << "\n" 
+      << "first " << result.first << "\n"
+      << "last " << result.last << "\n"
+      << "sets " << result.sets << "\n"
+      << "solvable " << result.solvable << "\n";
+}
+
+
+
+/*
+ * Name:        readResult
+ * Prototype:   readResult(istream & in, CensusResult & result);
+ * Description: This function reads back the counts written by writeResult.
+ * Parameters:
+ *    in          - Where to read the counts from
+ *    result      - Set to the counts that were read
+ * Return:      true if a well formed result was read, false if not.
+ */
+bool PuzzleCensus::readResult(istream & in, CensusResult & result) {
+
+  string header, firstLabel, lastLabel, setsLabel, solvableLabel;
+
+  getline(in, header);
+  in >> firstLabel >> result.first >> lastLabel >> result.last 
+      >> setsLabel >> result.sets >> solvableLabel >> result.solvable;
+
+  return in && header == CENSUS_HEADER && firstLabel == "first" && 
+      lastLabel == "last" && setsLabel == "sets" && 
+      solvableLabel == "solvable" && result.first <= result.last &&
+      result.sets == result.last - result.first &&
+      result.solvable >= 0 && result.solvable <= result.sets;
+}
+
+
+
+/*
+ * Name:        mergeResults
+ * Prototype:   mergeResults(vector<CensusResult> results, 
+ *                  CensusResult & merged);
+ * Description: This function adds up the counts of several ranges. The
+ *                ranges may be given in any order but must fit together
+ *                into one contiguous range with no gaps or overlaps, so a
+ *                merged result can itself be merged again later.
+ * Parameters:
+ *    results     - The counts of each range
+ *    merged      - Set to the counts of the combined range
+ * Return:      true if the ranges fit together, false if not.
+ */
+bool PuzzleCensus::mergeResults(vector<CensusResult> results, 
+    CensusResult & merged) {
+
+  if (results.empty()) {
+    return false;
+  }
+
+  sort(results.begin(), results.end(), 
+      [](const CensusResult & a, const CensusResult & b) {
+        return a.first < b.first;
+      });
+
+  merged = results[0];
+  for (size_t index = 1; index < results.size(); index++) {
+    if (results[index].first != merged.last) {
+      return false;
+    }
+    merged.last = results[index].last;
+    merged.sets += results[index].sets;
+    merged.solvable += results[index].solvable;
+  }
+
+  return true;
+}
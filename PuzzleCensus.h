@@ -0,0 +1,65 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleCensus.h
+ * Description: Header file for the PuzzleCensus class. Contains the code
+ *                to count the solvable sets in a range of set ranks, so the
+ *                whole space of sets can be split into shards that run on
+ *                separate machines and are merged afterwards.
+ */
+
+
+#ifndef _PUZZLECENSUS
+#define _PUZZLECENSUS
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include "HexPieces.h"
+#include "PieceSets.h"
+
+const std::string SHARD_FLAG = "--shard";
+const std::string MERGE_FLAG = "--merge";
+const int NUM_OF_SHARD_ARGS = 4;
+const int NUM_OF_MERGE_ARGS = 4;
+const long long CENSUS_CHUNK = 4096;
+const std::string CENSUS_HEADER = "hexpuzzle-census 1";
+const std::string SHARD_USAGE = "To count one shard of all the sets, please " \
+    "type in: ./hexexe --shard 0/8 shard_0.txt\n" \
+    "to count the first of 8 equal ranges of sets. An optional last " \
+    "argument sets the number of threads to use.\n" \
+    "To combine shard files, please type in: " \
+    "./hexexe --merge census.txt shard_0.txt shard_1.txt ...\n";
+
+/*The counts for one contiguous range of set ranks, [first, last)*/
+struct CensusResult {
+  long long first;
+  long long last;
+  long long sets;
+  long long solvable;
+};
+
+class PuzzleCensus {
+  public:
+    PuzzleCensus(int threadCount);
+    CensusResult countRange(long long first, long long last);
+    
+    static void shardRange(int shard, int shardCount, long long & first, 
+        long long & last);
+    static void writeResult(const CensusResult & result, std::ostream & out);
+    static bool readResult(std::istream & in, CensusResult & result);
+    static bool mergeResults(std::vector<CensusResult> results, 
+        CensusResult & merged);
+
+  private:
+    int threadCount;
+
+    /*the next rank not yet handed to a thread, and the end of the range*/
+    std::atomic<long long> nextRank;
+    long long lastRank;
+    std::atomic<long long> solvableCount;
+
+    void countChunks();
+};
+
+
+#endif
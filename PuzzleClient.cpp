@@ -0,0 +1,253 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleClient.cpp
+ * Description: Implementation file for the PuzzleClient class. Contains
+ *                the code to talk to the solve daemon.
+ */
+
+#include <string>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "PuzzleClient.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleClient
+ * Description:     Starts out unconnected.
+ */
+PuzzleClient::PuzzleClient() : fd(-1), nextRequestId(0) {
+}
+
+
+
+/* Destructor:      PuzzleClient
+ * Description:     Hangs up if connected.
+ */
+PuzzleClient::~PuzzleClient() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+
+
+/*
+ * Name:        connectTo
+ * Prototype:   connectTo(const string & socketPath);
+ * Description: This function connects to a daemon's socket.
+ * Parameters:
+ *    socketPath  - The daemon's socket
+ * Return:      true if connected, false if not.
+ */
+bool PuzzleClient::connectTo(const string & socketPath) {
+
+  struct sockaddr_un address;
+
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socketPath.c_str());
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  return fd >= 0 && 
+      connect(fd, (struct sockaddr *)&address, sizeof(address)) == 0;
+}
+
+
+
+/*
+ * Name:        sendRequest
+ * Prototype:   sendRequest(unsigned char op, unsigned int count,
+ *                  int puzzlePieces[][COLSIZE]);
+ * Description: This function sends one request without waiting for its
+ *                answer. Requests are numbered in the order they are sent.
+ * Parameters:
+ *    op            - The operation
+ *    count         - How many sets to generate, otherwise unused
+ *    puzzlePieces  - The set for solve, count and render requests, 
+ *                      otherwise unused
+ * Return:      true if the request was sent, false if not.
+ */
+bool PuzzleClient::sendRequest(unsigned char op, unsigned int count,
+    int puzzlePieces[][COLSIZE]) {
+
+  unsigned char request[REQUEST_HEADER_SIZE + SET_SIZE];
+  size_t length = REQUEST_HEADER_SIZE;
+
+  request[0] = op;
+  memcpy(request + 1, &nextRequestId, 4);
+  memcpy(request + 5, &count, 4);
+
+  if (op == OP_SOLVE || op == OP_COUNT || op == OP_RENDER) {
+    for (int border = 0; border < SET_SIZE; border++) {
+      request[length++] = 
+          (unsigned char)puzzlePieces[border / COLSIZE][border % COLSIZE];
+    }
+  }
+
+  sendTimes[nextRequestId++] = chrono::steady_clock::now();
+
+  return writeAll(fd, request, length);
+}
+
+
+
+/*
+ * Name:        receiveResponse
+ * Prototype:   receiveResponse(unsigned int & requestId, 
+ *                  unsigned char & status, string & payload);
+ * Description: This function waits for the next answer and times it.
+ *                Requests sent together may be answered by different
+ *                workers, so answers can arrive in any order.
+ * Parameters:
+ *    requestId   - Set to the number of the request answered
+ *    status      - Set to the status of the answer
+ *    payload     - Set to the bytes that follow the response header
+ * Return:      true if an answer to a waiting request arrived, false if
+ *              not.
+ */
+bool PuzzleClient::receiveResponse(unsigned int & requestId, 
+    unsigned char & status, string & payload) {
+
+  unsigned char header[RESPONSE_HEADER_SIZE];
+  unsigned int length = 0;
+
+  if (sendTimes.empty() || !readAll(fd, header, RESPONSE_HEADER_SIZE)) {
+    return false;
+  }
+
+  memcpy(&requestId, header, 4);
+  status = header[4];
+  memcpy(&length, header + 5, 4);
+
+  payload.assign(length, '\0');
+  if ((length && !readAll(fd, &payload[0], length)) || 
+      !sendTimes.count(requestId)) {
+    return false;
+  }
+
+  latencies.push_back(chrono::duration_cast<chrono::microseconds>(
+      chrono::steady_clock::now() - sendTimes[requestId]).count());
+  sendTimes.erase(requestId);
+
+  return true;
+}
+
+
+
+/*
+ * Name:        sendSets
+ * Prototype:   sendSets(unsigned char op, istream & in, ostream & out);
+ * Description: This function sends a request for every set read from in
+ *                and writes out the answers in the same order. Up to 
+ *                CLIENT_WINDOW requests are sent before their answers are
+ *                read, so the daemon can batch them.
+ * Parameters:
+ *    op          - The operation to ask for on every set
+ *    in          - Where to read the sets from
+ *    out         - Where to write the answers
+ * Return:      true if every set was answered and the input ended
+ *              cleanly, false if not.
+ */
+bool PuzzleClient::sendSets(unsigned char op, istream & in, ostream & out) {
+
+  PieceSet possibleSet;
+  unsigned int requestId = 0, windowStart = 0;
+  unsigned char status = 0;
+  string payload;
+  vector<unsigned char> statuses(CLIENT_WINDOW);
+  vector<string> payloads(CLIENT_WINDOW);
+  int readStatus = SET_READ;
+
+  while (readStatus == SET_READ) {
+    windowStart = nextRequestId;
+    while (sendTimes.size() < CLIENT_WINDOW && 
+        (readStatus = readASet(in, possibleSet.pieces)) == SET_READ) {
+      if (!sendRequest(op, 0, possibleSet.pieces)) {
+        return false;
+      }
+    }
+
+    /*answers are kept by position in the window until all have arrived*/
+    while (!sendTimes.empty()) {
+      if (!receiveResponse(requestId, status, payload)) {
+        return false;
+      }
+      statuses[requestId - windowStart] = status;
+      payloads[requestId - windowStart].swap(payload);
+    }
+
+    for (unsigned int index = 0; index < nextRequestId - windowStart; 
+        index++) {
+      printResponse(op, statuses[index], payloads[index], out);
+    }
+  }
+
+  return readStatus == NO_MORE_SETS;
+}
+
+
+
+/*
+ * Name:        printResponse
+ * Prototype:   printResponse(unsigned char op, unsigned char status,
+ *                  const string & payload, ostream & out);
+ * Description: This function writes out an answer in a readable form.
+ * Parameters:
+ *    op          - The operation that was asked for
+ *    status      - The status of the answer
+ *    payload     - The bytes that followed the response header
+ *    out         - Where to write the answer
+ */
+void PuzzleClient::printResponse(unsigned char op, unsigned char status,
+    const string & payload, ostream & out) {
+
+  int possibleSet[ROWSIZE][COLSIZE];
+  unsigned long long solutions = 0;
+
+  if (status == STATUS_BAD_REQUEST) {
+    out << "bad request\n";
+  }
+  else if (status == STATUS_UNSOLVABLE) {
+    out << "not solvable\n";
+  }
+  else if (op == OP_SOLVE && !payload.empty() && !payload[0]) {
+    out << "not solvable\n";
+  }
+  else if (op == OP_SOLVE || op == OP_GENERATE) {
+    /*solve answers start with the solvable flag*/
+    for (size_t start = (op == OP_SOLVE); start + SET_SIZE <= payload.size();
+        start += SET_SIZE) {
+      for (int border = 0; border < SET_SIZE; border++) {
+        possibleSet[border / COLSIZE][border % COLSIZE] = 
+            payload[start + border];
+      }
+      out << setToString(possibleSet);
+    }
+  }
+  else if (op == OP_COUNT && payload.size() == sizeof(solutions)) {
+    memcpy(&solutions, payload.data(), sizeof(solutions));
+    out << solutions << "\n";
+  }
+  else {
+    out << payload;
+  }
+}
+
+
+
+/*
+ * Name:        latencyReport
+ * Prototype:   latencyReport();
+ * Description: This function sums up how long the answers took, as seen
+ *                from the client.
+ * Return:      The latency percentiles on one line
+ */
+string PuzzleClient::latencyReport() {
+  return percentileReport(latencies);
+}
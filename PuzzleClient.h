@@ -0,0 +1,57 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleClient.h
+ * Description: Header file for the PuzzleClient class. Contains the code
+ *                to send requests to a PuzzleDaemon and time its answers.
+ */
+
+
+#ifndef _PUZZLECLIENT
+#define _PUZZLECLIENT
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include "HexPieces.h"
+#include "PieceSets.h"
+#include "PuzzleDaemon.h"
+
+const std::string CLIENT_FLAG = "--client";
+const int NUM_OF_CLIENT_ARGS = 4;
+const size_t CLIENT_WINDOW = 256;
+const std::string CLIENT_USAGE = "To send requests to the solve daemon, " \
+    "please type in one of:\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock solve puzzles.txt\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock count puzzles.txt\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock render puzzles.txt\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock generate 100\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock stats\n" \
+    "./hexexe --client /tmp/hexpuzzle.sock shutdown\n";
+
+class PuzzleClient {
+  public:
+    PuzzleClient();
+    ~PuzzleClient();
+    bool connectTo(const std::string & socketPath);
+    bool sendRequest(unsigned char op, unsigned int count, 
+        int puzzlePieces[][COLSIZE]);
+    bool receiveResponse(unsigned int & requestId, unsigned char & status, 
+        std::string & payload);
+    bool sendSets(unsigned char op, std::istream & in, std::ostream & out);
+    std::string latencyReport();
+    void printResponse(unsigned char op, unsigned char status, 
+        const std::string & payload, std::ostream & out);
+
+  private:
+    int fd;
+    unsigned int nextRequestId;
+
+    /*when each request still waiting for an answer was sent*/
+    std::unordered_map<unsigned int, std::chrono::steady_clock::time_point>
+        sendTimes;
+    std::vector<long long> latencies;
+};
+
+
+#endif
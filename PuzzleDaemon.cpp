@@ -0,0 +1,584 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleDaemon.cpp
+ * Description: Implementation file for the PuzzleDaemon class. Contains
+ *                the code to answer puzzle requests over a Unix domain
+ *                socket with a pool of worker threads.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <unordered_set>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "PuzzleDaemon.h"
+
+using namespace std;
+
+
+/* Constructor:     DaemonConnection
+ * Description:     Takes ownership of a connected socket, and limits how
+ *                  long a send to it may block to SEND_TIMEOUT_MS.
+ */
+DaemonConnection::DaemonConnection(int fd) : fd(fd), dropped(false) {
+  struct timeval timeout;
+
+  timeout.tv_sec = SEND_TIMEOUT_MS / 1000;
+  timeout.tv_usec = (SEND_TIMEOUT_MS % 1000) * 1000;
+  (void)setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+
+
+/* Destructor:      DaemonConnection
+ * Description:     Closes the socket.
+ */
+DaemonConnection::~DaemonConnection() {
+  close(fd);
+}
+
+
+
+/*
+ * Name:        readAll
+ * Prototype:   readAll(int fd, void * buffer, size_t length);
+ * Description: This function reads exactly length bytes from a socket,
+ *                however many reads that takes.
+ * Parameters:
+ *    fd          - The socket to read from
+ *    buffer      - Where to put the bytes
+ *    length      - How many bytes to read
+ * Return:      true if every byte was read, false if the socket closed or
+ *              failed first.
+ */
+bool readAll(int fd, void * buffer, size_t length) {
+
+  char * next = (char *)buffer;
+  ssize_t count = 0;
+
+  while (length > 0) {
+    count = recv(fd, next, length, 0);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    next += count;
+    length -= count;
+  }
+
+  return true;
+}
+
+
+
+/*
+ * Name:        writeAll
+ * Prototype:   writeAll(int fd, const void * buffer, size_t length);
+ * Description: This function writes exactly length bytes to a socket,
+ *                however many writes that takes. A peer that went away is
+ *                reported as a failure rather than raising SIGPIPE.
+ * Parameters:
+ *    fd          - The socket to write to
+ *    buffer      - The bytes to write
+ *    length      - How many bytes to write
+ * Return:      true if every byte was written, false if not.
+ */
+bool writeAll(int fd, const void * buffer, size_t length) {
+
+  const char * next = (const char *)buffer;
+  ssize_t count = 0;
+
+  while (length > 0) {
+    count = send(fd, next, length, MSG_NOSIGNAL);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    next += count;
+    length -= count;
+  }
+
+  return true;
+}
+
+
+
+/*
+ * Name:        claimSocketPath
+ * Prototype:   claimSocketPath(const string & socketPath);
+ * Description: This function makes the socket path free to bind. A socket
+ *                left behind by a daemon that is gone is removed, but
+ *                anything else at the path, or a socket another daemon is
+ *                still answering on, is left alone.
+ * Parameters:
+ *    socketPath  - Where the socket is to be created
+ * Return:      true if nothing is at the path anymore, false if it is in
+ *              use by something else.
+ */
+bool claimSocketPath(const string & socketPath) {
+
+  struct stat status;
+  struct sockaddr_un address;
+  int probeFd = -1;
+  bool live = false;
+
+  if (lstat(socketPath.c_str(), &status) < 0) {
+    return errno == ENOENT;
+  }
+  if (!S_ISSOCK(status.st_mode)) {
+    return false;
+  }
+
+  /*a socket that still takes connections belongs to a running daemon*/
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socketPath.c_str());
+  probeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (probeFd < 0) {
+    return false;
+  }
+  live = connect(probeFd, (struct sockaddr *)&address, sizeof(address)) == 0;
+  close(probeFd);
+
+  return !live && unlink(socketPath.c_str()) == 0;
+}
+
+
+
+/*
+ * Name:        percentileReport
+ * Prototype:   percentileReport(vector<long long> latencies);
+ * Description: This function sums up a list of latencies on one line,
+ *                using nearest-rank percentiles.
+ * Parameters:
+ *    latencies   - The latencies in microseconds, in any order
+ * Return:      The number of latencies and their percentiles
+ */
+string percentileReport(vector<long long> latencies) {
+
+  ostringstream report;
+  /*in tenths of a percent, so the ranks below are exact*/
+  const size_t perThousand[] = {500, 900, 990};
+  size_t rank = 0;
+
+  report << latencies.size() << " requests";
+  if (latencies.empty()) {
+    return report.str() + "\n";
+  }
+
+  sort(latencies.begin(), latencies.end());
+  for (int index = 0; index < 3; index++) {
+    /*nearest rank: the smallest latency at least that share of requests
+      took no longer than*/
+    rank = (perThousand[index] * latencies.size() + 999) / 1000;
+    report << ", p" << perThousand[index] / 10 << " " 
+        << latencies[rank - 1] << "us";
+  }
+  report << ", max " << latencies.back() << "us\n";
+
+  return report.str();
+}
+
+
+
+/* Constructor:     PuzzleDaemon
+ * Description:     Sets up an empty job queue for the given number of
+ *                  workers.
+ */
+PuzzleDaemon::PuzzleDaemon(int threadCount)
+    : threadCount(threadCount > 0 ? threadCount : 1), listenFd(-1),
+      stopping(false), jobs(DAEMON_QUEUE_CAPACITY), activeReaders(0),
+      latencyNext(0) {
+}
+
+
+
+/*
+ * Name:        serve
+ * Prototype:   serve(const string & socketPath);
+ * Description: This function answers requests on the given socket until
+ *                a shutdown request arrives. A reader thread per
+ *                connection queues requests, and the workers take them off
+ *                the queue in batches. Each worker keeps its own solver,
+ *                rater and random number generator for as long as the
+ *                daemon runs, and the board templates are read only once,
+ *                before the socket is set up.
+ * Parameters:
+ *    socketPath  - Where to create the socket
+ * Return:      true if the daemon ran and shut down cleanly, false if the
+ *              templates or the socket could not be set up, or the path
+ *              is in use.
+ */
+bool PuzzleDaemon::serve(const string & socketPath) {
+
+  struct sockaddr_un address;
+  vector<thread> workers;
+  random_device seeder;
+  HexPieces warmPuzzle;
+  int possibleSet[ROWSIZE][COLSIZE];
+  int clientFd = -1;
+
+  if (socketPath.size() >= sizeof(address.sun_path) || 
+      !warmPuzzle.loadTheTemplates()) {
+    return false;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, socketPath.c_str());
+  if (!claimSocketPath(socketPath)) {
+    return false;
+  }
+
+  listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0 ||
+      ::bind(listenFd, (struct sockaddr *)&address, sizeof(address)) < 0 ||
+      listen(listenFd, DAEMON_BACKLOG) < 0) {
+    if (listenFd >= 0) {
+      close(listenFd);
+    }
+    return false;
+  }
+
+  /*build the ranking tables before the first request rather than during
+    it*/
+  unrankASet(0, possibleSet);
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers.push_back(thread(&PuzzleDaemon::handleJobs, this, seeder()));
+  }
+
+  while (!stopping) {
+    clientFd = accept(listenFd, nullptr, nullptr);
+    if (clientFd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      break;
+    }
+
+    shared_ptr<DaemonConnection> connection(new DaemonConnection(clientFd));
+    {
+      lock_guard<mutex> guard(connectionsLock);
+      connections.erase(remove_if(connections.begin(), connections.end(),
+          [](const weak_ptr<DaemonConnection> & old) {
+            return old.expired();
+          }), connections.end());
+      connections.push_back(connection);
+      activeReaders++;
+    }
+    thread(&PuzzleDaemon::readRequests, this, connection).detach();
+  }
+
+  /*stop reading new requests, then let the workers answer what is left*/
+  {
+    unique_lock<mutex> guard(connectionsLock);
+    for (size_t index = 0; index < connections.size(); index++) {
+      shared_ptr<DaemonConnection> connection = connections[index].lock();
+      if (connection) {
+        shutdown(connection->fd, SHUT_RD);
+      }
+    }
+    readersDone.wait(guard, [this] { return activeReaders == 0; });
+  }
+
+  jobs.close();
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+
+  close(listenFd);
+  unlink(socketPath.c_str());
+  return true;
+}
+
+
+
+/*
+ * Name:        readRequests
+ * Prototype:   readRequests(shared_ptr<DaemonConnection> connection);
+ * Description: This function queues every request sent on a connection
+ *                until the client hangs up, sends an operation it does not
+ *                know, or the daemon shuts down.
+ * Parameters:
+ *    connection  - The connection to read from
+ */
+void PuzzleDaemon::readRequests(shared_ptr<DaemonConnection> connection) {
+
+  unsigned char header[REQUEST_HEADER_SIZE];
+  unsigned char borderNumbers[SET_SIZE];
+  DaemonJob job;
+  bool knownOp = true;
+
+  job.connection = connection;
+
+  while (knownOp && readAll(connection->fd, header, REQUEST_HEADER_SIZE)) {
+    job.op = header[0];
+    memcpy(&job.requestId, header + 1, sizeof(job.requestId));
+    memcpy(&job.count, header + 5, sizeof(job.count));
+
+    if (job.op == OP_SOLVE || job.op == OP_COUNT || job.op == OP_RENDER) {
+      if (!readAll(connection->fd, borderNumbers, SET_SIZE)) {
+        break;
+      }
+      for (int border = 0; border < SET_SIZE; border++) {
+        job.possibleSet.pieces[border / COLSIZE][border % COLSIZE] =
+            borderNumbers[border];
+      }
+    }
+
+    /*without knowing its length, nothing after an unknown request can be
+      read, so answer it and hang up*/
+    knownOp = job.op >= OP_SOLVE && job.op <= OP_SHUTDOWN;
+
+    job.arrival = chrono::steady_clock::now();
+    if (!jobs.push(job)) {
+      break;
+    }
+  }
+
+  lock_guard<mutex> guard(connectionsLock);
+  activeReaders--;
+  readersDone.notify_all();
+}
+
+
+
+/*
+ * Name:        handleJobs
+ * Prototype:   handleJobs(unsigned int seed);
+ * Description: This function answers queued requests until the queue is
+ *                closed. Requests are taken DAEMON_BATCH at a time, and
+ *                the answers in a batch that go to the same connection are
+ *                sent with one write. A client too slow to take its
+ *                answers within SEND_TIMEOUT_MS is dropped, so it cannot
+ *                hold up the worker for longer than that.
+ * Parameters:
+ *    seed        - The seed for this worker's random number generator
+ */
+void PuzzleDaemon::handleJobs(unsigned int seed) {
+
+  HexPieces solverPuzzle;
+  PuzzleRater rater;
+  mt19937 generator(seed);
+  vector<DaemonJob> batch;
+  vector<string> responses;
+  vector<bool> sent;
+  string payload, combined;
+  unsigned char header[RESPONSE_HEADER_SIZE];
+  unsigned int length = 0;
+  bool shutdownRequested = false;
+
+  while (jobs.popBatch(batch, DAEMON_BATCH)) {
+    responses.assign(batch.size(), "");
+    sent.assign(batch.size(), false);
+
+    for (size_t index = 0; index < batch.size(); index++) {
+      header[4] = handleAJob(batch[index], solverPuzzle, rater, generator,
+          payload);
+      length = (unsigned int)payload.size();
+      memcpy(header, &batch[index].requestId, 4);
+      memcpy(header + 5, &length, 4);
+      responses[index].assign((const char *)header, RESPONSE_HEADER_SIZE);
+      responses[index] += payload;
+      shutdownRequested = shutdownRequested ||
+          batch[index].op == OP_SHUTDOWN;
+    }
+
+    /*send each connection everything meant for it at once*/
+    for (size_t index = 0; index < batch.size(); index++) {
+      if (sent[index]) {
+        continue;
+      }
+
+      combined.clear();
+      for (size_t other = index; other < batch.size(); other++) {
+        if (batch[other].connection == batch[index].connection) {
+          combined += responses[other];
+          sent[other] = true;
+        }
+      }
+
+      {
+        DaemonConnection & connection = *batch[index].connection;
+        lock_guard<mutex> guard(connection.writeLock);
+
+        /*a half written answer leaves the stream unreadable, so a client
+          that times out is cut off rather than written to again*/
+        if (!connection.dropped && 
+            !writeAll(connection.fd, combined.data(), combined.size())) {
+          connection.dropped = true;
+          shutdown(connection.fd, SHUT_RDWR);
+        }
+      }
+
+      for (size_t other = index; other < batch.size(); other++) {
+        if (batch[other].connection == batch[index].connection) {
+          recordLatency(chrono::duration_cast<chrono::microseconds>(
+              chrono::steady_clock::now() - batch[other].arrival).count());
+        }
+      }
+    }
+
+    /*let go of the connections so finished ones close right away*/
+    batch.clear();
+
+    if (shutdownRequested) {
+      shutdownRequested = false;
+      stop();
+    }
+  }
+}
+
+
+
+/*
+ * Name:        handleAJob
+ * Prototype:   handleAJob(DaemonJob & job, HexPieces & solverPuzzle,
+ *                  PuzzleRater & rater, mt19937 & generator,
+ *                  string & payload);
+ * Description: This function works out the answer to one request.
+ * Parameters:
+ *    job           - The request
+ *    solverPuzzle  - The worker's solver
+ *    rater         - The worker's rater, used to count solutions
+ *    generator     - The worker's random number generator
+ *    payload       - Set to the bytes that follow the response header
+ * Return:      The status of the response
+ */
+unsigned char PuzzleDaemon::handleAJob(DaemonJob & job,
+    HexPieces & solverPuzzle, PuzzleRater & rater, mt19937 & generator,
+    string & payload) {
+
+  int solution[ROWSIZE][COLSIZE];
+  unsigned long long solutions = 0;
+  bool solvable = false;
+  unordered_set<unsigned long long> seenSets;
+  PieceSet possibleSet;
+
+  payload.clear();
+
+  if ((job.op == OP_SOLVE || job.op == OP_COUNT || job.op == OP_RENDER) &&
+      !isAValidSet(job.possibleSet.pieces)) {
+    return STATUS_BAD_REQUEST;
+  }
+
+  if (job.op == OP_SOLVE || job.op == OP_RENDER) {
+    solvable = solverPuzzle.isTheRandomSetSolvable(job.possibleSet.pieces, 0);
+    if (job.op == OP_RENDER) {
+      if (!solvable) {
+        return STATUS_UNSOLVABLE;
+      }
+      payload = solverPuzzle.renderTheSolution(job.possibleSet.pieces);
+      return STATUS_OK;
+    }
+
+    /*whether it was solvable, then the solved board tile by tile*/
+    payload += (char)solvable;
+    if (solvable) {
+      solverPuzzle.copyTheSolution(job.possibleSet.pieces, solution);
+      for (int border = 0; border < SET_SIZE; border++) {
+        payload += (char)solution[border / COLSIZE][border % COLSIZE];
+      }
+    }
+    return STATUS_OK;
+  }
+  else if (job.op == OP_COUNT) {
+    solutions = rater.rate(job.possibleSet.pieces, false).solutions;
+    payload.assign((const char *)&solutions, sizeof(solutions));
+    return STATUS_OK;
+  }
+  else if (job.op == OP_GENERATE) {
+    if (job.count > MAX_GENERATE) {
+      return STATUS_BAD_REQUEST;
+    }
+
+    while (seenSets.size() < job.count) {
+      solverPuzzle.generateARandomSet(possibleSet.pieces, generator);
+      if (!solverPuzzle.isTheRandomSetSolvable(possibleSet.pieces, 0) ||
+          !seenSets.insert(canonicalKey(possibleSet.pieces)).second) {
+        continue;
+      }
+      for (int border = 0; border < SET_SIZE; border++) {
+        payload += 
+            (char)possibleSet.pieces[border / COLSIZE][border % COLSIZE];
+      }
+    }
+    return STATUS_OK;
+  }
+  else if (job.op == OP_STATS) {
+    payload = latencyReport();
+    return STATUS_OK;
+  }
+  else if (job.op == OP_SHUTDOWN) {
+    return STATUS_OK;
+  }
+
+  return STATUS_BAD_REQUEST;
+}
+
+
+
+/*
+ * Name:        recordLatency
+ * Prototype:   recordLatency(long long microseconds);
+ * Description: This function remembers how long a request took, from
+ *                being read to being answered, overwriting the oldest once
+ *                LATENCY_WINDOW are remembered.
+ * Parameters:
+ *    microseconds  - How long the request took
+ */
+void PuzzleDaemon::recordLatency(long long microseconds) {
+  lock_guard<mutex> guard(latencyLock);
+
+  if (latencies.size() < LATENCY_WINDOW) {
+    latencies.push_back(microseconds);
+  }
+  else {
+    latencies[latencyNext] = microseconds;
+  }
+  latencyNext = (latencyNext + 1) % LATENCY_WINDOW;
+}
+
+
+
+/*
+ * Name:        latencyReport
+ * Prototype:   latencyReport();
+ * Description: This function sums up the latencies of recent requests.
+ * Return:      The latency percentiles on one line
+ */
+string PuzzleDaemon::latencyReport() {
+
+  vector<long long> recent;
+
+  {
+    lock_guard<mutex> guard(latencyLock);
+    recent = latencies;
+  }
+
+  return percentileReport(recent);
+}
+
+
+
+/*
+ * Name:        stop
+ * Prototype:   stop();
+ * Description: This function stops the daemon accepting connections,
+ *                which makes serve wind everything down.
+ */
+void PuzzleDaemon::stop() {
+  stopping = true;
+  shutdown(listenFd, SHUT_RDWR);
+}
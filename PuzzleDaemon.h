@@ -0,0 +1,135 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleDaemon.h
+ * Description: Header file for the PuzzleDaemon class. Contains the code
+ *                for a long running process that answers puzzle requests
+ *                over a Unix domain socket, and the binary protocol it
+ *                speaks.
+ *
+ *              Every request starts with a 9 byte header: the operation
+ *                (1 byte), a request id (4 bytes) and a count (4 bytes).
+ *                Solve, count and render requests follow it with the 42
+ *                border numbers of a set, one byte each. Every response
+ *                starts with the request id (4 bytes), a status (1 byte)
+ *                and the length of what follows (4 bytes). Numbers are in
+ *                host byte order, since both ends run on the same machine.
+ */
+
+
+#ifndef _PUZZLEDAEMON
+#define _PUZZLEDAEMON
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <condition_variable>
+#include "HexPieces.h"
+#include "PieceSets.h"
+#include "PuzzleRater.h"
+#include "BoundedQueue.h"
+
+const std::string DAEMON_FLAG = "--daemon";
+const int NUM_OF_DAEMON_ARGS = 3;
+const std::string DAEMON_USAGE = "To start the solve daemon, please type " \
+    "in: ./hexexe --daemon /tmp/hexpuzzle.sock\n" \
+    "to answer requests on that socket until a shutdown request arrives. " \
+    "An optional last argument sets the number of worker threads.\n";
+
+const int REQUEST_HEADER_SIZE = 9;
+const int RESPONSE_HEADER_SIZE = 9;
+const int SET_SIZE = ROWSIZE * COLSIZE;
+const int DAEMON_BATCH = 64;
+const int DAEMON_QUEUE_CAPACITY = 4096;
+const int DAEMON_BACKLOG = 64;
+const unsigned int MAX_GENERATE = 4096;
+const size_t LATENCY_WINDOW = 65536;
+
+/*how long a worker may wait on a client that is not reading its answers
+  before that client is dropped*/
+const int SEND_TIMEOUT_MS = 2000;
+
+/*operations; solve answers whether the set is solvable followed by the
+  solved board, count the number of solutions as 8 bytes, generate count
+  unique solvable sets, render the drawing of the solved board, and stats
+  the daemon's latency percentiles as text*/
+const unsigned char OP_SOLVE = 1;
+const unsigned char OP_COUNT = 2;
+const unsigned char OP_GENERATE = 3;
+const unsigned char OP_RENDER = 4;
+const unsigned char OP_STATS = 5;
+const unsigned char OP_SHUTDOWN = 6;
+
+const unsigned char STATUS_OK = 0;
+const unsigned char STATUS_UNSOLVABLE = 1;
+const unsigned char STATUS_BAD_REQUEST = 2;
+
+/*A client connection. The socket is closed when the last job holding the
+  connection is done with it. Once a send times out the connection is
+  dropped and nothing more is written to it*/
+struct DaemonConnection {
+  int fd;
+  std::mutex writeLock;
+  bool dropped;
+
+  explicit DaemonConnection(int fd);
+  ~DaemonConnection();
+};
+
+/*One request waiting for a worker*/
+struct DaemonJob {
+  std::shared_ptr<DaemonConnection> connection;
+  unsigned char op;
+  unsigned int requestId;
+  unsigned int count;
+  PieceSet possibleSet;
+  std::chrono::steady_clock::time_point arrival;
+};
+
+bool readAll(int fd, void * buffer, size_t length);
+
+bool writeAll(int fd, const void * buffer, size_t length);
+
+bool claimSocketPath(const std::string & socketPath);
+
+std::string percentileReport(std::vector<long long> latencies);
+
+class PuzzleDaemon {
+  public:
+    PuzzleDaemon(int threadCount);
+    bool serve(const std::string & socketPath);
+    std::string latencyReport();
+
+  private:
+    int threadCount;
+    int listenFd;
+    std::atomic<bool> stopping;
+    BoundedQueue<DaemonJob> jobs;
+
+    /*connections still being read, so they can be cut off at shutdown*/
+    std::mutex connectionsLock;
+    std::condition_variable readersDone;
+    std::vector<std::weak_ptr<DaemonConnection> > connections;
+    int activeReaders;
+
+    /*the last LATENCY_WINDOW request latencies in microseconds*/
+    std::mutex latencyLock;
+    std::vector<long long> latencies;
+    size_t latencyNext;
+
+    void readRequests(std::shared_ptr<DaemonConnection> connection);
+
+    void handleJobs(unsigned int seed);
+
+    unsigned char handleAJob(DaemonJob & job, HexPieces & solverPuzzle,
+        PuzzleRater & rater, std::mt19937 & generator, std::string & payload);
+
+    void recordLatency(long long microseconds);
+
+    void stop();
+};
+
+
+#endif
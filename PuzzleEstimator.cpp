@@ -0,0 +1,195 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleEstimator.cpp
+ * Description: Implementation file for the PuzzleEstimator class. Contains
+ *                the code to estimate how many sets are solvable.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include "PuzzleEstimator.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleEstimator
+ * Description:     Remembers how many threads to sample with.
+ */
+PuzzleEstimator::PuzzleEstimator(int threadCount) 
+    : threadCount(threadCount > 0 ? threadCount : 1), precision(0), z(0),
+      sampleCount(0), solvableCount(0), done(false) {
+}
+
+
+
+/*
+ * Name:        estimate
+ * Prototype:   estimate(double precision, double confidence, 
+ *                  ostream & progress);
+ * Description: This function samples sets on every thread until the
+ *                confidence interval for the solvable fraction is within
+ *                precision of the estimate on both sides. The running
+ *                estimate is written to progress about once a second. Only
+ *                the two counts are kept, so memory does not grow with the
+ *                number of samples.
+ * Parameters:
+ *    precision   - The largest half width of the interval to stop at
+ *    confidence  - The confidence level of the interval, e.g. 0.95
+ *    progress    - Where to write the running estimate
+ * Return:      The final estimate and its interval
+ */
+EstimateResult PuzzleEstimator::estimate(double precision, double confidence,
+    ostream & progress) {
+
+  vector<thread> workers;
+  random_device seeder;
+  EstimateResult result;
+  long long solvable = 0;
+
+  this->precision = precision;
+  z = zScore(confidence);
+  sampleCount = 0;
+  solvableCount = 0;
+  done = false;
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers.push_back(thread(&PuzzleEstimator::sampleSets, this, seeder()));
+  }
+
+  /*report the running estimate until a thread decides it is precise
+    enough*/
+  {
+    unique_lock<mutex> guard(doneLock);
+    while (!doneSignal.wait_for(guard,
+        chrono::milliseconds(PROGRESS_MILLISECONDS),
+        [this] { return done.load(); })) {
+      solvable = solvableCount;
+      result = interval(sampleCount, solvable, z);
+      progress << result.samples << " samples: " << result.estimate 
+          << " [" << result.low << ", " << result.high << "]" << endl;
+    }
+  }
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+
+  solvable = solvableCount;
+  return interval(sampleCount, solvable, z);
+}
+
+
+
+/*
+ * Name:        sampleSets
+ * Prototype:   sampleSets(unsigned int seed);
+ * Description: This function keeps solving batches of sets until the
+ *                estimate is precise enough. Every set comes from
+ *                sampleASet, so each set of 7 distinct pieces is equally
+ *                likely no matter how fast sets are drawn.
+ * Parameters:
+ *    seed        - The seed for this thread's random number generator
+ */
+void PuzzleEstimator::sampleSets(unsigned int seed) {
+
+  HexPieces samplePuzzle;
+  mt19937_64 generator(seed);
+  int possibleSet[ROWSIZE][COLSIZE];
+  long long solvable = 0, samples = 0;
+  EstimateResult result;
+
+  while (!done) {
+    solvable = 0;
+    for (long long sample = 0; sample < ESTIMATE_BATCH; sample++) {
+      sampleASet(generator, possibleSet);
+      if (samplePuzzle.isTheRandomSetSolvable(possibleSet, 0)) {
+        solvable++;
+      }
+    }
+
+    /*samples are added before and read after the solvable count, so the
+      solvable count read is never ahead of the samples read*/
+    sampleCount += ESTIMATE_BATCH;
+    solvable = (solvableCount += solvable);
+    samples = sampleCount;
+
+    result = interval(samples, solvable, z);
+    if (samples >= ESTIMATE_MIN_SAMPLES && 
+        result.high - result.low <= 2 * precision) {
+      lock_guard<mutex> guard(doneLock);
+      done = true;
+      doneSignal.notify_all();
+    }
+  }
+}
+
+
+
+/*
+ * Name:        zScore
+ * Prototype:   zScore(double confidence);
+ * Description: This function finds how many standard deviations either
+ *                side of the mean cover the given fraction of a normal
+ *                distribution, by bisecting on erfc.
+ * Parameters:
+ *    confidence  - The fraction to cover, between 0 and 1
+ * Return:      The z score, e.g. about 1.96 for 0.95
+ */
+double PuzzleEstimator::zScore(double confidence) {
+
+  double low = 0, high = 10, middle = 0;
+
+  for (int step = 0; step < 100; step++) {
+    middle = (low + high) / 2;
+    if (erfc(middle / sqrt(2.0)) > 1 - confidence) {
+      low = middle;
+    }
+    else {
+      high = middle;
+    }
+  }
+
+  return middle;
+}
+
+
+
+/*
+ * Name:        interval
+ * Prototype:   interval(long long samples, long long solvable, double z);
+ * Description: This function finds the Wilson score interval for the
+ *                solvable fraction, which stays sensible even when very
+ *                few or very many of the samples are solvable.
+ * Parameters:
+ *    samples     - How many sets were sampled
+ *    solvable    - How many of them were solvable
+ *    z           - The z score of the confidence level
+ * Return:      The estimate and its interval
+ */
+EstimateResult PuzzleEstimator::interval(long long samples, 
+    long long solvable, double z) {
+
+  EstimateResult result;
+  double fraction = 0, center = 0, halfWidth = 0, scale = 0;
+
+  result.samples = samples;
+  result.solvable = solvable;
+  result.estimate = 0; result.low = 0; result.high = 1;
+  if (samples <= 0) {
+    return result;
+  }
+
+  fraction = (double)solvable / samples;
+  scale = 1 + z * z / samples;
+  center = (fraction + z * z / (2 * samples)) / scale;
+  halfWidth = z * sqrt(fraction * (1 - fraction) / samples + 
+      z * z / (4.0 * samples * samples)) / scale;
+
+  result.estimate = fraction;
+  result.low = center - halfWidth;
+  result.high = center + halfWidth;
+  return result;
+}
@@ -0,0 +1,69 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleEstimator.h
+ * Description: Header file for the PuzzleEstimator class. Contains the
+ *                code to estimate the fraction of sets that are solvable
+ *                by solving uniformly sampled sets until the confidence
+ *                interval is narrow enough.
+ */
+
+
+#ifndef _PUZZLEESTIMATOR
+#define _PUZZLEESTIMATOR
+
+#include <iostream>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include "HexPieces.h"
+#include "PieceSets.h"
+
+const std::string ESTIMATE_FLAG = "--estimate";
+const int NUM_OF_ESTIMATE_ARGS = 3;
+const double DEFAULT_CONFIDENCE = 0.95;
+const long long ESTIMATE_BATCH = 1024;
+const long long ESTIMATE_MIN_SAMPLES = 10000;
+const int PROGRESS_MILLISECONDS = 1000;
+const std::string ESTIMATE_USAGE = "To estimate the fraction of solvable " \
+    "sets, please type in: ./hexexe --estimate 0.001\n" \
+    "to sample until the estimate is within 0.001 either way. Optional " \
+    "arguments set the confidence level (default 0.95) and then the " \
+    "number of threads to use.\n";
+
+/*A running estimate and its confidence interval*/
+struct EstimateResult {
+  long long samples;
+  long long solvable;
+  double estimate;
+  double low;
+  double high;
+};
+
+class PuzzleEstimator {
+  public:
+    PuzzleEstimator(int threadCount);
+    EstimateResult estimate(double precision, double confidence, 
+        std::ostream & progress);
+
+    static double zScore(double confidence);
+    static EstimateResult interval(long long samples, long long solvable, 
+        double z);
+
+  private:
+    int threadCount;
+
+    /*the interval half width to stop at, and its z score*/
+    double precision;
+    double z;
+
+    std::atomic<long long> sampleCount;
+    std::atomic<long long> solvableCount;
+    std::atomic<bool> done;
+    std::mutex doneLock;
+    std::condition_variable doneSignal;
+
+    void sampleSets(unsigned int seed);
+};
+
+
+#endif
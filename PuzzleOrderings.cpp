@@ -0,0 +1,125 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleOrderings.cpp
+ * Description: Implementation file for the PuzzleOrderings class. Contains
+ *                the code to compare the orders solveIt can try pieces in.
+ */
+
+#include <thread>
+#include <random>
+#include <chrono>
+#include <mutex>
+#include "PuzzleOrderings.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleOrderings
+ * Description:     Remembers how many threads to solve with.
+ */
+PuzzleOrderings::PuzzleOrderings(int threadCount) 
+    : threadCount(threadCount > 0 ? threadCount : 1) {
+}
+
+
+
+/*
+ * Name:        compare
+ * Prototype:   compare(long long samples, ostream & out);
+ * Description: This function solves the same uniformly sampled sets once
+ *                with each ordering mode, one mode at a time, and writes
+ *                out for each the average number of pieces solveIt placed,
+ *                over all sets and for solvable and unsolvable sets
+ *                separately, and how long the mode took.
+ * Parameters:
+ *    samples     - How many sets to sample
+ *    out         - Where to write the comparison
+ */
+void PuzzleOrderings::compare(long long samples, ostream & out) {
+
+  random_device seeder;
+  OrderingResult result;
+  long long sets = 0;
+
+  seeds.clear();
+  for (int worker = 0; worker < threadCount; worker++) {
+    seeds.push_back(seeder());
+  }
+
+  for (int mode = 0; mode < NUM_OF_ORDERINGS; mode++) {
+    result = solveSamples(mode, samples);
+    sets = result.sets[0] + result.sets[1];
+
+    if (mode == 0) {
+      out << "Average pieces placed per set over " << sets << " sets, " 
+          << result.sets[1] << " solvable and " << result.sets[0] 
+          << " unsolvable:\n";
+    }
+    out << ORDERING_NAMES[mode] << ": overall " 
+        << (sets ? (double)(result.nodes[0] + result.nodes[1]) / sets : 0)
+        << ", solvable " 
+        << (result.sets[1] ? (double)result.nodes[1] / result.sets[1] : 0)
+        << ", unsolvable " 
+        << (result.sets[0] ? (double)result.nodes[0] / result.sets[0] : 0)
+        << ", " << result.seconds << "s\n";
+  }
+}
+
+
+
+/*
+ * Name:        solveSamples
+ * Prototype:   solveSamples(int orderingMode, long long samples);
+ * Description: This function solves samples sets with one ordering mode,
+ *                split evenly over every thread. Each thread draws its
+ *                sets from its own seed, so every mode gets the same sets.
+ * Parameters:
+ *    orderingMode  - The order solveIt tries pieces in
+ *    samples       - How many sets to solve
+ * Return:      The sets and pieces placed, split by whether the set was
+ *              solvable, and the wall time taken.
+ */
+OrderingResult PuzzleOrderings::solveSamples(int orderingMode, 
+    long long samples) {
+
+  vector<thread> workers;
+  mutex totalsLock;
+  OrderingResult result = {{0, 0}, {0, 0}, 0};
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    long long share = samples / threadCount + 
+        (worker < samples % threadCount ? 1 : 0);
+    unsigned int seed = seeds[worker];
+
+    workers.push_back(thread([&, share, seed] {
+      HexPieces orderedPuzzle;
+      mt19937_64 generator(seed);
+      int possibleSet[ROWSIZE][COLSIZE];
+      long long sets[2] = {0, 0};
+      long long nodes[2] = {0, 0};
+      bool solvable = false;
+
+      orderedPuzzle.orderingMode = orderingMode;
+      for (long long sample = 0; sample < share; sample++) {
+        sampleASet(generator, possibleSet);
+        solvable = orderedPuzzle.isTheRandomSetSolvable(possibleSet, 0);
+        nodes[solvable] += orderedPuzzle.nodesVisited;
+        sets[solvable]++;
+      }
+
+      lock_guard<mutex> guard(totalsLock);
+      for (int solved = 0; solved < 2; solved++) {
+        result.sets[solved] += sets[solved];
+        result.nodes[solved] += nodes[solved];
+      }
+    }));
+  }
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+
+  result.seconds = chrono::duration_cast<chrono::duration<double> >(
+      chrono::steady_clock::now() - start).count();
+  return result;
+}
@@ -0,0 +1,39 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleOrderings.h
+ * Description: Header file for the PuzzleOrderings class. Contains the
+ *                code to measure how fast solveIt is with each order it can
+ *                try pieces in, on the same uniformly sampled sets.
+ */
+
+
+#ifndef _PUZZLEORDERINGS
+#define _PUZZLEORDERINGS
+
+#include <iostream>
+#include <vector>
+#include "HexPieces.h"
+#include "PieceSets.h"
+
+/*What one ordering mode cost over every sampled set*/
+struct OrderingResult {
+  long long sets[2];
+  long long nodes[2];
+  double seconds;
+};
+
+class PuzzleOrderings {
+  public:
+    PuzzleOrderings(int threadCount);
+    void compare(long long samples, std::ostream & out);
+
+  private:
+    int threadCount;
+
+    /*one seed per thread, so every mode solves the same sets*/
+    std::vector<unsigned int> seeds;
+
+    OrderingResult solveSamples(int orderingMode, long long samples);
+};
+
+
+#endif
@@ -0,0 +1,200 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzlePipeline.cpp
+ * Description: Implementation file for the PuzzlePipeline class. Contains
+ *                the code to mass produce unique, solvable puzzles.
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <random>
+#include "PuzzlePipeline.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzlePipeline
+ * Description:     Splits the threads between generating and solving,
+ *                  giving one generator to every SOLVERS_PER_GENERATOR
+ *                  threads and the rest to solving. At least one thread
+ *                  does each.
+ */
+PuzzlePipeline::PuzzlePipeline(int threadCount) 
+    : target(0), accepted(0), sinceAccepted(0), filterByDifficulty(false), 
+      lowestDifficulty(0), highestDifficulty(0), candidates(QUEUE_CAPACITY) {
+
+  generatorCount = threadCount / (SOLVERS_PER_GENERATOR + 1) > 0
+      ? threadCount / (SOLVERS_PER_GENERATOR + 1) : 1;
+  solverCount = threadCount - generatorCount > 0 
+      ? threadCount - generatorCount : 1;
+}
+
+
+
+/*
+ * Name:        setDifficultyRange
+ * Prototype:   setDifficultyRange(double lowest, double highest);
+ * Description: This function makes produce keep only the solvable sets
+ *                whose PuzzleRater difficulty is within the given range.
+ * Parameters:
+ *    lowest      - The lowest difficulty to keep
+ *    highest     - The highest difficulty to keep
+ */
+void PuzzlePipeline::setDifficultyRange(double lowest, double highest) {
+  filterByDifficulty = true;
+  lowestDifficulty = lowest;
+  highestDifficulty = highest;
+}
+
+
+
+/*
+ * Name:        produce
+ * Prototype:   produce(long long count, ostream & out);
+ * Description: This function writes count unique, solvable sets of puzzle
+ *                pieces to out as they are found. Generator threads fill a
+ *                bounded queue with random sets, and solver threads empty
+ *                it, so only the queue and the keys of the accepted sets
+ *                are ever held in memory. The keys grow with count, at
+ *                about 16 bytes per set. It stops early if
+ *                STALL_ATTEMPTS sets in a row are turned down.
+ * Parameters:
+ *    count       - How many sets to produce
+ *    out         - Where to write the sets
+ * Return:      The number of sets written, which is less than count if it
+ *              stopped early.
+ */
+long long PuzzlePipeline::produce(long long count, ostream & out) {
+
+  vector<thread> workers;
+  random_device seeder;
+
+  target = count;
+  if (target <= 0) {
+    return 0;
+  }
+
+  for (int generator = 0; generator < generatorCount; generator++) {
+    workers.push_back(thread(&PuzzlePipeline::generateSets, this, 
+        seeder()));
+  }
+  for (int solver = 0; solver < solverCount; solver++) {
+    workers.push_back(thread(&PuzzlePipeline::solveSets, this, ref(out)));
+  }
+
+  for (size_t worker = 0; worker < workers.size(); worker++) {
+    workers[worker].join();
+  }
+
+  out.flush();
+  return accepted < target ? accepted.load() : target;
+}
+
+
+
+/*
+ * Name:        generateSets
+ * Prototype:   generateSets(unsigned int seed);
+ * Description: This function keeps putting random sets on the queue until
+ *                the queue is closed. Sets that were already accepted are
+ *                skipped without being queued, but still count as turned
+ *                down.
+ * Parameters:
+ *    seed        - The seed for this thread's random number generator
+ */
+void PuzzlePipeline::generateSets(unsigned int seed) {
+
+  HexPieces generatorPuzzle;
+  mt19937 generator(seed);
+  PieceSet possibleSet;
+
+  while (true) {
+    generatorPuzzle.generateARandomSet(possibleSet.pieces, generator);
+    if (seenSets.contains(canonicalKey(possibleSet.pieces))) {
+      if (turnDown()) {
+        return;
+      }
+      continue;
+    }
+    if (!candidates.push(possibleSet)) {
+      return;
+    }
+  }
+}
+
+
+
+/*
+ * Name:        solveSets
+ * Prototype:   solveSets(ostream & out);
+ * Description: This function takes sets off the queue and solves them, or
+ *                rates them if a difficulty range was set. Each solvable 
+ *                set in range and not seen before is written to out. Once
+ *                enough sets are written the queue is closed, which stops
+ *                every other thread.
+ * Parameters:
+ *    out         - Where to write the sets
+ */
+void PuzzlePipeline::solveSets(ostream & out) {
+
+  HexPieces solverPuzzle;
+  PuzzleRater rater;
+  PuzzleRating rating;
+  PieceSet possibleSet;
+  string formedSet;
+
+  while (candidates.pop(possibleSet)) {
+    if (filterByDifficulty) {
+      rating = rater.rate(possibleSet.pieces, false);
+      if (!rating.solvable || rating.difficulty < lowestDifficulty ||
+          rating.difficulty > highestDifficulty) {
+        turnDown();
+        continue;
+      }
+    }
+    else if (!solverPuzzle.isTheRandomSetSolvable(possibleSet.pieces, 0)) {
+      turnDown();
+      continue;
+    }
+
+    if (!seenSets.insert(canonicalKey(possibleSet.pieces))) {
+      turnDown();
+      continue;
+    }
+    sinceAccepted = 0;
+
+    /*claim a slot in the output, dropping the set if enough were found*/
+    long long slot = accepted++;
+    if (slot >= target) {
+      continue;
+    }
+
+    formedSet = setToString(possibleSet.pieces);
+    {
+      lock_guard<mutex> guard(outLock);
+      out << formedSet;
+    }
+
+    if (slot + 1 == target) {
+      candidates.close();
+    }
+  }
+}
+
+
+
+/*
+ * Name:        turnDown
+ * Prototype:   turnDown();
+ * Description: This function notes that a set was turned down, and closes
+ *                the queue once STALL_ATTEMPTS sets in a row have been.
+ * Return:      true if the pipeline has given up, false if not.
+ */
+bool PuzzlePipeline::turnDown() {
+  if (++sinceAccepted < STALL_ATTEMPTS) {
+    return false;
+  }
+
+  candidates.close();
+  return true;
+}
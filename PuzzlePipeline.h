@@ -0,0 +1,69 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzlePipeline.h
+ * Description: Header file for the PuzzlePipeline class. Contains the code
+ *                to mass produce unique, solvable sets of puzzle pieces
+ *                using generator threads that feed solver threads.
+ */
+
+
+#ifndef _PUZZLEPIPELINE
+#define _PUZZLEPIPELINE
+
+#include <iostream>
+#include <mutex>
+#include <atomic>
+#include "HexPieces.h"
+#include "PieceSets.h"
+#include "BoundedQueue.h"
+#include "ConcurrentKeySet.h"
+#include "PuzzleRater.h"
+
+const std::string COUNT_FLAG = "--count";
+const int NUM_OF_COUNT_ARGS = 4;
+const int QUEUE_CAPACITY = 1024;
+
+/*making a random set is far cheaper than solving one, so one generator
+  keeps many solvers busy*/
+const int SOLVERS_PER_GENERATOR = 16;
+const std::string COUNT_USAGE = "To mass produce puzzles, please type in: " \
+    "./hexexe --count 1000 puzzles.txt\n" \
+    "to write 1000 unique, solvable sets to puzzles.txt. An optional " \
+    "last argument sets the number of threads to use.\n";
+
+class PuzzlePipeline {
+  public:
+    PuzzlePipeline(int threadCount);
+    long long produce(long long count, std::ostream & out);
+    void setDifficultyRange(double lowest, double highest);
+
+  private:
+    /*number of generator and solver threads to run*/
+    int generatorCount;
+    int solverCount;
+    
+    /*how many unique solvable sets are wanted, and how many were found*/
+    long long target;
+    std::atomic<long long> accepted;
+
+    /*how many sets were turned down since one was last accepted*/
+    std::atomic<long long> sinceAccepted;
+
+    /*whether only sets rated within [lowestDifficulty, highestDifficulty]
+      are accepted*/
+    bool filterByDifficulty;
+    double lowestDifficulty;
+    double highestDifficulty;
+
+    BoundedQueue<PieceSet> candidates;
+    ConcurrentKeySet seenSets;
+    std::mutex outLock;
+
+    void generateSets(unsigned int seed);
+
+    void solveSets(std::ostream & out);
+
+    bool turnDown();
+};
+
+
+#endif
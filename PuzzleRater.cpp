@@ -0,0 +1,278 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleRater.cpp
+ * Description: Implementation file for the PuzzleRater class. Contains
+ *                the code to rate the difficulty of sets of puzzle pieces.
+ */
+
+#include <string>
+#include <sstream>
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include "PuzzleRater.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleRater
+ * Description:     Starts with no set loaded.
+ */
+PuzzleRater::PuzzleRater() : centerTile(0) {
+}
+
+
+
+/*
+ * Name:        rate
+ * Prototype:   rate(int puzzlePieces[][COLSIZE], bool countSolverNodes);
+ * Description: This function rates a set of puzzle pieces. For each of
+ *                the 7 center tiles, an exhaustive search counts the
+ *                solutions and the partial boards at each depth, and a
+ *                greedy walk finds how far a player who never takes a
+ *                piece back gets. Since a piece never repeats a border
+ *                number, the number a ring tile must match on the center
+ *                tile fixes its rotation, so both only ever choose pieces.
+ *                The difficulty is log2 of the partial boards per
+ *                solution, plus a point for every ring tile the greedy
+ *                player falls short of filling. Counting solverNodes takes
+ *                a separate run of solveIt, so it is only done if asked.
+ * Parameters:
+ *    puzzlePieces      - The set of puzzle pieces to rate
+ *    countSolverNodes  - Whether to run solveIt to fill in solverNodes
+ * Return:      The rating, with a difficulty of -1 if the set is not
+ *              solvable, and solverNodes -1 if it was not counted.
+ */
+PuzzleRating PuzzleRater::rate(int puzzlePieces[][COLSIZE], 
+    bool countSolverNodes) {
+
+  PuzzleRating rating;
+  int greedyTotal = 0;
+
+  rating.solutions = 0;
+  rating.searchNodes = 0;
+  rating.solverNodes = -1;
+  for (int depth = 0; depth < ROWSIZE; depth++) {
+    rating.nodesAtDepth[depth] = 0;
+  }
+
+  /*copy the set so solveIt can rotate it, and find every border number*/
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    for (int borderNumber = 0; borderNumber < COLSIZE; borderNumber++) {
+      pieces[tileNumber][borderNumber] = 
+          puzzlePieces[tileNumber][borderNumber];
+      positions[tileNumber][puzzlePieces[tileNumber][borderNumber]] = 
+          borderNumber;
+    }
+  }
+
+  for (centerTile = 0; centerTile < ROWSIZE; centerTile++) {
+    rating.nodesAtDepth[0]++;
+    searchRing(0, 1 << centerTile, 0, 0, rating);
+    greedyTotal += greedyRing();
+  }
+
+  for (int depth = 0; depth < ROWSIZE; depth++) {
+    rating.searchNodes += rating.nodesAtDepth[depth];
+  }
+
+  rating.solvable = rating.solutions > 0;
+  rating.greedyDepth = (double)greedyTotal / ROWSIZE;
+  rating.difficulty = rating.solvable 
+      ? log2((double)rating.searchNodes / rating.solutions) + 
+        (COLSIZE - rating.greedyDepth)
+      : -1;
+
+  /*how much work the real solver does to find its first solution*/
+  if (countSolverNodes) {
+    (void)solverPuzzle.isTheRandomSetSolvable(pieces, 0);
+    rating.solverNodes = solverPuzzle.nodesVisited;
+  }
+
+  return rating;
+}
+
+
+
+/*
+ * Name:        searchRing
+ * Prototype:   searchRing(int direction, int usedPieces, int previousEdge,
+ *                  int firstEdge, PuzzleRating & rating);
+ * Description: This function tries every unused piece on the given ring
+ *                tile and recurses on those that fit, counting every fit.
+ * Parameters:
+ *    direction     - The ring tile to fill, 0 = north, 1 = northeast, etc
+ *    usedPieces    - A bit for every piece already on the board
+ *    previousEdge  - The number the last ring tile shows this one
+ *    firstEdge     - The number the north tile shows the northwest tile
+ *    rating        - The counts to add to
+ */
+void PuzzleRater::searchRing(int direction, int usedPieces, int previousEdge,
+    int firstEdge, PuzzleRating & rating) {
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    if (usedPieces & (1 << tileNumber)) {
+      continue;
+    }
+
+    /*it must match the ring tile before it, and the last ring tile must
+      also match the first*/
+    if (direction && edgeValue(tileNumber, direction, 
+        (direction + 4) % COLSIZE) != previousEdge) {
+      continue;
+    }
+    if (direction == COLSIZE - 1 && 
+        edgeValue(tileNumber, direction, 1) != firstEdge) {
+      continue;
+    }
+
+    rating.nodesAtDepth[direction + 1]++;
+    if (direction == COLSIZE - 1) {
+      rating.solutions++;
+      continue;
+    }
+
+    searchRing(direction + 1, usedPieces | (1 << tileNumber), 
+        edgeValue(tileNumber, direction, (direction + 2) % COLSIZE),
+        direction ? firstEdge : edgeValue(tileNumber, direction, 4), rating);
+  }
+}
+
+
+
+/*
+ * Name:        greedyRing
+ * Prototype:   greedyRing();
+ * Description: This function fills the ring around the current center
+ *                tile like a player who always takes the first piece that
+ *                fits and never takes one back.
+ * Return:      How many ring tiles were placed before getting stuck, 6 if
+ *              the ring was filled.
+ */
+int PuzzleRater::greedyRing() {
+
+  int usedPieces = 1 << centerTile, previousEdge = 0, firstEdge = 0;
+  int tileNumber = 0;
+
+  for (int direction = 0; direction < COLSIZE; direction++) {
+    for (tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+      if ((usedPieces & (1 << tileNumber)) || (direction && 
+          edgeValue(tileNumber, direction, (direction + 4) % COLSIZE) != 
+          previousEdge) || (direction == COLSIZE - 1 && 
+          edgeValue(tileNumber, direction, 1) != firstEdge)) {
+        continue;
+      }
+      break;
+    }
+
+    /*nothing fits, so the player is stuck*/
+    if (tileNumber == ROWSIZE) {
+      return direction;
+    }
+
+    usedPieces |= 1 << tileNumber;
+    previousEdge = edgeValue(tileNumber, direction, (direction + 2) % COLSIZE);
+    if (!direction) {
+      firstEdge = edgeValue(tileNumber, direction, 4);
+    }
+  }
+
+  return COLSIZE;
+}
+
+
+
+/*
+ * Name:        edgeValue
+ * Prototype:   edgeValue(int tileNumber, int direction, int edge);
+ * Description: This function finds a border number of a piece placed on
+ *                a ring tile, turned so it matches the center tile.
+ *                Edge (direction + 3) touches the center tile, edge
+ *                (direction + 2) the next ring tile and edge (direction + 4)
+ *                the previous one, all modulo 6.
+ * Parameters:
+ *    tileNumber    - The piece on the ring tile
+ *    direction     - The ring tile, 0 = north, 1 = northeast, etc
+ *    edge          - The edge to look up, numbered like rotateTile's
+ * Return:      The border number on that edge
+ */
+int PuzzleRater::edgeValue(int tileNumber, int direction, int edge) {
+
+  int rotations = (positions[tileNumber][pieces[centerTile][direction]] - 
+      (direction + 3) + 2 * COLSIZE) % COLSIZE;
+
+  return pieces[tileNumber][(edge + rotations) % COLSIZE];
+}
+
+
+
+/*
+ * Name:        rateBatch
+ * Prototype:   rateBatch(vector<PieceSet> & sets, 
+ *                  vector<PuzzleRating> & ratings, int threadCount);
+ * Description: This function rates many sets at once, each thread taking
+ *                the next unrated set until none are left.
+ * Parameters:
+ *    sets          - The sets to rate
+ *    ratings       - Set to the rating of each set, in the same order
+ *    threadCount   - How many threads to rate with
+ */
+void PuzzleRater::rateBatch(vector<PieceSet> & sets, 
+    vector<PuzzleRating> & ratings, int threadCount) {
+
+  vector<thread> workers;
+  atomic<size_t> nextSet(0);
+
+  ratings.resize(sets.size());
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers.push_back(thread([&sets, &ratings, &nextSet] {
+      PuzzleRater rater;
+      size_t index = 0;
+      while ((index = nextSet++) < sets.size()) {
+        ratings[index] = rater.rate(sets[index].pieces, true);
+      }
+    }));
+  }
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+}
+
+
+
+/*
+ * Name:        ratingHeader
+ * Prototype:   ratingHeader();
+ * Description: This function names the columns written by ratingToString.
+ * Return:      The column names
+ */
+string PuzzleRater::ratingHeader() {
+  return "# difficulty solutions searchNodes solverNodes greedyDepth " \
+      "nodesAtDepth0-6\n";
+}
+
+
+
+/*
+ * Name:        ratingToString
+ * Prototype:   ratingToString(const PuzzleRating & rating);
+ * Description: This function writes out a rating on one line.
+ * Parameters:
+ *    rating        - The rating to write
+ * Return:      The formatted rating
+ */
+string PuzzleRater::ratingToString(const PuzzleRating & rating) {
+
+  ostringstream formedString;
+
+  formedString << rating.difficulty << " " << rating.solutions << " " 
+      << rating.searchNodes << " " << rating.solverNodes << " " 
+      << rating.greedyDepth;
+  for (int depth = 0; depth < ROWSIZE; depth++) {
+    formedString << " " << rating.nodesAtDepth[depth];
+  }
+  formedString << "\n";
+
+  return formedString.str();
+}
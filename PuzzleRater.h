@@ -0,0 +1,75 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleRater.h
+ * Description: Header file for the PuzzleRater class. Contains the code
+ *                to measure how hard a set of puzzle pieces is to solve.
+ */
+
+
+#ifndef _PUZZLERATER
+#define _PUZZLERATER
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "HexPieces.h"
+#include "PieceSets.h"
+
+const std::string RATE_FLAG = "--rate";
+const std::string DIFFICULTY_FLAG = "--difficulty";
+const int NUM_OF_RATE_ARGS = 4;
+const int NUM_OF_DIFFICULTY_ARGS = 6;
+const int RATE_BATCH = 4096;
+const std::string RATE_USAGE = "To rate sets, please type in: " \
+    "./hexexe --rate puzzles.txt ratings.txt\n" \
+    "to rate every set in puzzles.txt. To produce sets within a range of " \
+    "difficulty, please type in: " \
+    "./hexexe --difficulty 6 8 1000 puzzles.txt\n" \
+    "to write 1000 unique sets rated between 6 and 8. Either can take an " \
+    "optional last argument for the number of threads to use.\n";
+
+/*How hard a set is. Depth 0 is the center tile and depth 6 is the last
+  ring tile*/
+struct PuzzleRating {
+  bool solvable;
+  /*solutions, counting rotations of the whole board once*/
+  long long solutions;
+  /*partial boards reached with every tile fitting, by number of tiles*/
+  long long nodesAtDepth[ROWSIZE];
+  long long searchNodes;
+  /*pieces placed by solveIt before finding the first solution, or -1 if
+    it was not counted*/
+  long long solverNodes;
+  /*ring tiles placed on average before a player who never takes a piece
+    back gets stuck, over all 7 choices of center tile*/
+  double greedyDepth;
+  double difficulty;
+};
+
+class PuzzleRater {
+  public:
+    PuzzleRater();
+    PuzzleRating rate(int puzzlePieces[][COLSIZE], bool countSolverNodes);
+
+    static void rateBatch(std::vector<PieceSet> & sets, 
+        std::vector<PuzzleRating> & ratings, int threadCount);
+    static std::string ratingToString(const PuzzleRating & rating);
+    static std::string ratingHeader();
+
+  private:
+    HexPieces solverPuzzle;
+    
+    /*the set being rated, and where each border number sits on each piece*/
+    int pieces[ROWSIZE][COLSIZE];
+    int positions[ROWSIZE][COLSIZE + 1];
+    int centerTile;
+
+    void searchRing(int direction, int usedPieces, int previousEdge, 
+        int firstEdge, PuzzleRating & rating);
+
+    int greedyRing();
+
+    int edgeValue(int tileNumber, int direction, int edge);
+};
+
+
+#endif
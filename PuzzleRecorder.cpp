@@ -0,0 +1,302 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleRecorder.cpp
+ * Description: Implementation file for the PuzzleRecorder and
+ *                PuzzleExporter classes. Contains the code to export solve
+ *                animations to recording files.
+ */
+
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <random>
+#include <ctime>
+#include <sys/stat.h>
+#include "PuzzleRecorder.h"
+
+using namespace std;
+
+
+/* Constructor:     PuzzleRecorder
+ * Description:     Sets up an empty recording in the given format, either
+ *                  CAST_FORMAT or FRAMES_FORMAT.
+ */
+PuzzleRecorder::PuzzleRecorder(const string & format, int frameTime)
+    : format(format), frameTime(frameTime), frameCount(0) {
+}
+
+
+
+/*
+ * Name:        start
+ * Prototype:   start(const string & title);
+ * Description: This function throws away anything recorded so far and
+ *                starts a new recording. An asciicast recording starts
+ *                with its header line.
+ * Parameters:
+ *    title       - The title of the recording
+ */
+void PuzzleRecorder::start(const string & title) {
+
+  ostringstream header;
+
+  frameCount = 0;
+  recording.clear();
+
+  if (format == CAST_FORMAT) {
+    header << "{\"version\": 2, \"width\": " << TERMINAL_WIDTH 
+        << ", \"height\": " << TERMINAL_HEIGHT << ", \"timestamp\": " 
+        << time(0) << ", \"title\": \"" << escapeJson(title) << "\"}\n";
+  }
+  else {
+    header << title << "\n";
+  }
+
+  recording += header.str();
+}
+
+
+
+/*
+ * Name:        addFrame
+ * Prototype:   addFrame(const string & picture);
+ * Description: This function adds a frame to the recording, stamped with
+ *                the time it would have been shown during live playback.
+ *                An asciicast frame clears the screen like 
+ *                displayThePicture does, and uses the carriage return and
+ *                line feed pairs a terminal expects.
+ * Parameters:
+ *    picture     - The frame, as drawn by renderThePicture
+ */
+void PuzzleRecorder::addFrame(const string & picture) {
+
+  ostringstream event;
+  string terminalText = "\x1b[H\x1b[2J";
+  double seconds = (double)frameCount * frameTime / ONE_SECOND;
+
+  event << fixed << setprecision(6);
+
+  if (format == CAST_FORMAT) {
+    for (size_t index = 0; index < picture.size(); index++) {
+      if (picture[index] == '\n') {
+        terminalText += "\r\n";
+      }
+      else if (picture[index] != '\r') {
+        terminalText += picture[index];
+      }
+    }
+    event << "[" << seconds << ", \"o\", \"" << escapeJson(terminalText)
+        << "\"]\n";
+  }
+  else {
+    event << "--- frame " << frameCount << " at " << seconds << "s ---\n"
+        << picture;
+  }
+
+  recording += event.str();
+  frameCount++;
+}
+
+
+
+/*
+ * Name:        writeTo
+ * Prototype:   writeTo(const string & fileName);
+ * Description: This function writes the whole recording to a file in one
+ *                go.
+ * Parameters:
+ *    fileName    - The file to write
+ * Return:      true if the file was written, false if not.
+ */
+bool PuzzleRecorder::writeTo(const string & fileName) {
+
+  ofstream outFile(fileName.c_str(), ios::out | ios::binary);
+
+  outFile.write(recording.data(), recording.size());
+  outFile.close();
+
+  return !outFile.fail();
+}
+
+
+
+/*
+ * Name:        frames
+ * Prototype:   frames();
+ * Description: This function tells how many frames have been recorded.
+ * Return:      The number of frames
+ */
+long long PuzzleRecorder::frames() {
+  return frameCount;
+}
+
+
+
+/*
+ * Name:        escapeJson
+ * Prototype:   escapeJson(const string & text);
+ * Description: This function makes text safe to put between the quotes
+ *                of a JSON string.
+ * Parameters:
+ *    text        - The text to escape
+ * Return:      The escaped text
+ */
+string PuzzleRecorder::escapeJson(const string & text) {
+
+  ostringstream escaped;
+
+  for (size_t index = 0; index < text.size(); index++) {
+    unsigned char letter = text[index];
+
+    if (letter == '"' || letter == '\\') {
+      escaped << '\\' << letter;
+    }
+    else if (letter == '\n') {
+      escaped << "\\n";
+    }
+    else if (letter == '\r') {
+      escaped << "\\r";
+    }
+    else if (letter < 0x20) {
+      escaped << "\\u" << hex << setw(4) << setfill('0') << (int)letter 
+          << dec;
+    }
+    else {
+      escaped << letter;
+    }
+  }
+
+  return escaped.str();
+}
+
+
+
+/* Constructor:     PuzzleExporter
+ * Description:     Remembers how to record and how many threads to use.
+ */
+PuzzleExporter::PuzzleExporter(const string & format, int frameTime, 
+    int threadCount)
+    : format(format), frameTime(frameTime), 
+      threadCount(threadCount > 0 ? threadCount : 1), nextPuzzle(0), 
+      written(0), target(0), sinceAccepted(0) {
+}
+
+
+
+/*
+ * Name:        exportPuzzles
+ * Prototype:   exportPuzzles(long long count, const string & directory);
+ * Description: This function records solving count unique, solvable
+ *                puzzles, one file each, spread over every thread. The
+ *                solver runs exactly as it does for the live display, but
+ *                frames are stamped with their playback time rather than
+ *                waited out, so exporting takes as long as solving.
+ * Parameters:
+ *    count       - How many puzzles to record
+ *    directory   - Where to put the files, created if missing
+ * Return:      The number of files written, which is less than count if
+ *              new solvable sets ran out, or -1 if the board templates
+ *              could not be read.
+ */
+long long PuzzleExporter::exportPuzzles(long long count, 
+    const string & directory) {
+
+  vector<thread> workers;
+  random_device seeder;
+  HexPieces templatePuzzle;
+
+  /*every frame would be blank without the templates*/
+  if (!templatePuzzle.loadTheTemplates()) {
+    return -1;
+  }
+
+  mkdir(directory.c_str(), 0755);
+
+  this->directory = directory;
+  target = count;
+  nextPuzzle = 0;
+  written = 0;
+  sinceAccepted = 0;
+
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers.push_back(thread(&PuzzleExporter::recordPuzzles, this, 
+        seeder()));
+  }
+  for (int worker = 0; worker < threadCount; worker++) {
+    workers[worker].join();
+  }
+
+  return written;
+}
+
+
+
+/*
+ * Name:        recordPuzzles
+ * Prototype:   recordPuzzles(unsigned int seed);
+ * Description: This function keeps claiming the next puzzle number,
+ *                finding a new solvable set for it and recording its
+ *                solve, until every puzzle number is claimed. Like the
+ *                pipeline, it gives up once STALL_ATTEMPTS sets in a row
+ *                were unsolvable or already recorded.
+ * Parameters:
+ *    seed        - The seed for this thread's random number generator
+ */
+void PuzzleExporter::recordPuzzles(unsigned int seed) {
+
+  HexPieces exportPuzzle;
+  PuzzleRecorder recorder(format, frameTime);
+  mt19937 generator(seed);
+  int possibleSet[ROWSIZE][COLSIZE];
+  long long puzzleNumber = 0;
+
+  exportPuzzle.frameTime = frameTime;
+
+  while ((puzzleNumber = nextPuzzle++) < target) {
+    exportPuzzle.generateARandomSet(possibleSet, generator);
+    while (!exportPuzzle.isTheRandomSetSolvable(possibleSet, 0) ||
+        !seenSets.insert(canonicalKey(possibleSet))) {
+      /*give up on every puzzle left once too many sets in a row fail*/
+      if (++sinceAccepted >= STALL_ATTEMPTS) {
+        nextPuzzle = target;
+        return;
+      }
+      exportPuzzle.generateARandomSet(possibleSet, generator);
+    }
+    sinceAccepted = 0;
+
+    /*replay the solve the way main does, into the recorder*/
+    recorder.start("Hex puzzle " + to_string(puzzleNumber));
+    exportPuzzle.recorder = &recorder;
+    (void)exportPuzzle.isTheRandomSetSolvable(possibleSet, 1);
+    exportPuzzle.recorder = nullptr;
+
+    if (recorder.writeTo(fileName(puzzleNumber))) {
+      written++;
+    }
+  }
+}
+
+
+
+/*
+ * Name:        fileName
+ * Prototype:   fileName(long long puzzleNumber);
+ * Description: This function names the file for a puzzle, padding the
+ *                number so the files sort in order.
+ * Parameters:
+ *    puzzleNumber  - The puzzle, 0 to count - 1
+ * Return:      The path of the file
+ */
+string PuzzleExporter::fileName(long long puzzleNumber) {
+
+  ostringstream name;
+  int digits = (int)to_string(target > 0 ? target - 1 : 0).size();
+
+  name << directory << "/puzzle_" << setw(digits) << setfill('0') 
+      << puzzleNumber << (format == CAST_FORMAT ? ".cast" : ".txt");
+
+  return name.str();
+}
@@ -0,0 +1,75 @@
+/* Author:      Vincent Sevilla
+ * Filename:    PuzzleRecorder.h
+ * Description: Header file for the PuzzleRecorder and PuzzleExporter
+ *                classes. Contains the code to record the frames of a
+ *                solve into a file instead of playing them on the console,
+ *                and to record many puzzles at once.
+ */
+
+
+#ifndef _PUZZLERECORDER
+#define _PUZZLERECORDER
+
+#include <string>
+#include <atomic>
+#include "HexPieces.h"
+#include "PieceSets.h"
+#include "ConcurrentKeySet.h"
+
+const std::string EXPORT_FLAG = "--export";
+const int NUM_OF_EXPORT_ARGS = 4;
+const std::string CAST_FORMAT = "cast";
+const std::string FRAMES_FORMAT = "frames";
+const int TERMINAL_WIDTH = 40;
+const int TERMINAL_HEIGHT = 24;
+const std::string EXPORT_USAGE = "To export solve animations, please type " \
+    "in: ./hexexe --export 1000 recordings\n" \
+    "to record solving 1000 unique puzzles into the recordings directory. " \
+    "Optional arguments set the format (cast for asciicast v2, the " \
+    "default, or frames for plain text), the frame time (default 1 " \
+    "second) and then the number of threads to use.\n";
+
+class PuzzleRecorder {
+  public:
+    PuzzleRecorder(const std::string & format, int frameTime);
+    void start(const std::string & title);
+    void addFrame(const std::string & picture);
+    bool writeTo(const std::string & fileName);
+    long long frames();
+
+  private:
+    std::string format;
+    /*time of one frame in microseconds, as in HexPieces*/
+    int frameTime;
+    long long frameCount;
+    std::string recording;
+
+    static std::string escapeJson(const std::string & text);
+};
+
+class PuzzleExporter {
+  public:
+    PuzzleExporter(const std::string & format, int frameTime, 
+        int threadCount);
+    long long exportPuzzles(long long count, const std::string & directory);
+
+  private:
+    std::string format;
+    int frameTime;
+    int threadCount;
+
+    std::atomic<long long> nextPuzzle;
+    std::atomic<long long> written;
+    long long target;
+    /*how many sets were turned down since one was last recorded*/
+    std::atomic<long long> sinceAccepted;
+    std::string directory;
+    ConcurrentKeySet seenSets;
+
+    void recordPuzzles(unsigned int seed);
+
+    std::string fileName(long long puzzleNumber);
+};
+
+
+#endif
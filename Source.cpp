@@ -6,10 +6,663 @@
 #include <iostream>
 #include "HexPieces.h"
 #include <fstream>
+#include <thread>
+#include "PuzzlePipeline.h"
+#include "PuzzleCensus.h"
+#include "PuzzleEstimator.h"
+#include "PuzzleRater.h"
+#include "PuzzleDaemon.h"
+#include "PuzzleClient.h"
+#include "PuzzleRecorder.h"
+#include "PuzzleOrderings.h"
 
 using namespace std;
 
 
+/*
+ * Name:        threadsToUse
+ * Prototype:   int threadsToUse(int argc, char * argv[], int argIndex);
+ * Description: This function reads an optional thread count argument,
+ *                falling back to the number of cores.
+ * Parameters:
+ *    argc      -Num of parameters.
+ *    argv      -The parameters.
+ *    argIndex  -Where the thread count would be.
+ * Return:      The number of threads to use, at least 1.
+ */
+int threadsToUse(int argc, char * argv[], int argIndex) {
+
+  int threadCount = (int)thread::hardware_concurrency();
+
+  if (argc > argIndex) {
+    threadCount = stoi(argv[argIndex], nullptr);
+  }
+
+  return threadCount > 0 ? threadCount : 1;
+}
+
+
+
+/*
+ * Name:        runCountMode
+ * Prototype:   int runCountMode(int argc, char * argv[]);
+ * Description: This function drives the mass production of puzzles.
+ * Parameters:
+ *    argc      -Num of parameters, should be 3 or 4.
+ *    argv[2]   -How many unique solvable sets to produce.
+ *    argv[3]   -The file to write the sets to.
+ *    argv[4]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runCountMode(int argc, char * argv[]) {
+
+  long long count = 0, produced = 0;
+  int threadCount = 1;
+  ofstream outFile;
+
+  if (argc != NUM_OF_COUNT_ARGS && argc != NUM_OF_COUNT_ARGS + 1) {
+    cout << COUNT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    count = stoll(argv[2], nullptr);
+    threadCount = threadsToUse(argc, argv, NUM_OF_COUNT_ARGS);
+    if (count < 0) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << COUNT_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << COUNT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  outFile.open(argv[3], ios::out);
+  if (!outFile) {
+    cout << "Could not open " << argv[3] << " for writing.\n";
+    return EXIT_FAILURE;
+  }
+
+  PuzzlePipeline pipeline(threadCount);
+  produced = pipeline.produce(count, outFile);
+  outFile.close();
+
+  cout << "Wrote " << produced << " unique solvable sets to " << argv[3] 
+      << "." << endl;
+
+  if (produced < count) {
+    cout << "Stopped after " << STALL_ATTEMPTS << " sets in a row were " \
+        "turned down, " << count - produced << " short.\n";
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
+
+
+/*
+ * Name:        runShardMode
+ * Prototype:   int runShardMode(int argc, char * argv[]);
+ * Description: This function drives counting one shard of all the sets.
+ * Parameters:
+ *    argc      -Num of parameters, should be 4 or 5.
+ *    argv[2]   -Which shard to count and how many there are, as i/k.
+ *    argv[3]   -The file to write the shard's counts to.
+ *    argv[4]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runShardMode(int argc, char * argv[]) {
+
+  int shard = 0, shardCount = 0, threadCount = 1;
+  long long first = 0, last = 0;
+  size_t slash = 0;
+  string shardArg;
+  ofstream outFile;
+
+  if (argc != NUM_OF_SHARD_ARGS && argc != NUM_OF_SHARD_ARGS + 1) {
+    cout << SHARD_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    shardArg = argv[2];
+    slash = shardArg.find('/');
+    shard = stoi(shardArg.substr(0, slash), nullptr);
+    shardCount = stoi(shardArg.substr(slash + 1), nullptr);
+    threadCount = threadsToUse(argc, argv, NUM_OF_SHARD_ARGS);
+    if (slash == string::npos || shardCount <= 0 || shard < 0 || 
+        shard >= shardCount) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << SHARD_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << SHARD_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  outFile.open(argv[3], ios::out);
+  if (!outFile) {
+    cout << "Could not open " << argv[3] << " for writing.\n";
+    return EXIT_FAILURE;
+  }
+
+  PuzzleCensus census(threadCount);
+  PuzzleCensus::shardRange(shard, shardCount, first, last);
+  CensusResult result = census.countRange(first, last);
+  PuzzleCensus::writeResult(result, outFile);
+  outFile.close();
+
+  cout << "Shard " << shard << "/" << shardCount << ": " << result.solvable 
+      << " of " << result.sets << " sets are solvable." << endl;
+
+  return 0;
+}
+
+
+
+/*
+ * Name:        runMergeMode
+ * Prototype:   int runMergeMode(int argc, char * argv[]);
+ * Description: This function drives combining shard files into one.
+ * Parameters:
+ *    argc      -Num of parameters, should be at least 4.
+ *    argv[2]   -The file to write the combined counts to.
+ *    argv[3..] -The shard files to combine.
+ * Return:      success or failure of execution
+ */
+int runMergeMode(int argc, char * argv[]) {
+
+  vector<CensusResult> results;
+  CensusResult result, merged;
+  ifstream inFile;
+  ofstream outFile;
+
+  if (argc < NUM_OF_MERGE_ARGS) {
+    cout << SHARD_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  for (int argIndex = 3; argIndex < argc; argIndex++) {
+    inFile.open(argv[argIndex], ios::in);
+    if (!PuzzleCensus::readResult(inFile, result)) {
+      cout << argv[argIndex] << " is not a shard file.\n";
+      return EXIT_FAILURE;
+    }
+    inFile.close();
+    results.push_back(result);
+  }
+
+  if (!PuzzleCensus::mergeResults(results, merged)) {
+    cout << "The shards leave a gap or overlap, so they cannot be merged.\n";
+    return EXIT_FAILURE;
+  }
+
+  outFile.open(argv[2], ios::out);
+  if (!outFile) {
+    cout << "Could not open " << argv[2] << " for writing.\n";
+    return EXIT_FAILURE;
+  }
+  PuzzleCensus::writeResult(merged, outFile);
+  outFile.close();
+
+  cout << merged.solvable << " of " << merged.sets << " sets are solvable";
+  if (merged.first != 0 || merged.last != NUM_OF_SETS) {
+    cout << " (ranks " << merged.first << " to " << merged.last - 1 
+        << " only)";
+  }
+  cout << "." << endl;
+
+  return 0;
+}
+
+
+
+/*
+ * Name:        runEstimateMode
+ * Prototype:   int runEstimateMode(int argc, char * argv[]);
+ * Description: This function drives estimating the solvable fraction.
+ * Parameters:
+ *    argc      -Num of parameters, should be 3 to 5.
+ *    argv[2]   -How close the estimate must be, e.g. 0.001.
+ *    argv[3]   -Optionally, the confidence level, e.g. 0.95.
+ *    argv[4]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runEstimateMode(int argc, char * argv[]) {
+
+  double precision = 0, confidence = DEFAULT_CONFIDENCE;
+  int threadCount = 1;
+
+  if (argc < NUM_OF_ESTIMATE_ARGS || argc > NUM_OF_ESTIMATE_ARGS + 2) {
+    cout << ESTIMATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    precision = stod(argv[2], nullptr);
+    if (argc > NUM_OF_ESTIMATE_ARGS) {
+      confidence = stod(argv[NUM_OF_ESTIMATE_ARGS], nullptr);
+    }
+    threadCount = threadsToUse(argc, argv, NUM_OF_ESTIMATE_ARGS + 1);
+    if (precision <= 0 || precision >= 0.5 || confidence <= 0 || 
+        confidence >= 1) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << ESTIMATE_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << ESTIMATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  PuzzleEstimator estimator(threadCount);
+  EstimateResult result = estimator.estimate(precision, confidence, cout);
+
+  cout << result.solvable << " of " << result.samples << " sampled sets "
+      << "were solvable." << endl << "Estimated solvable fraction: " 
+      << result.estimate << ", " << confidence * 100 << "% interval [" 
+      << result.low << ", " << result.high << "]" << endl;
+
+  return 0;
+}
+
+
+
+/*
+ * Name:        runRateMode
+ * Prototype:   int runRateMode(int argc, char * argv[]);
+ * Description: This function drives rating a file of sets. Sets are read
+ *                and rated RATE_BATCH at a time, so the file can be any
+ *                size.
+ * Parameters:
+ *    argc      -Num of parameters, should be 4 or 5.
+ *    argv[2]   -The file of sets to rate, as written by --count.
+ *    argv[3]   -The file to write one rating per set to.
+ *    argv[4]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runRateMode(int argc, char * argv[]) {
+
+  int threadCount = 1, readStatus = SET_READ;
+  long long rated = 0;
+  vector<PieceSet> sets;
+  vector<PuzzleRating> ratings;
+  PieceSet possibleSet;
+  ifstream inFile;
+  ofstream outFile;
+
+  if (argc != NUM_OF_RATE_ARGS && argc != NUM_OF_RATE_ARGS + 1) {
+    cout << RATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    threadCount = threadsToUse(argc, argv, NUM_OF_RATE_ARGS);
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << RATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  inFile.open(argv[2], ios::in);
+  outFile.open(argv[3], ios::out);
+  if (!inFile || !outFile) {
+    cout << "Could not open " << argv[2] << " and " << argv[3] << ".\n";
+    return EXIT_FAILURE;
+  }
+
+  outFile << PuzzleRater::ratingHeader();
+  while (readStatus == SET_READ) {
+    sets.clear();
+    while (sets.size() < RATE_BATCH && 
+        (readStatus = readASet(inFile, possibleSet.pieces)) == SET_READ) {
+      sets.push_back(possibleSet);
+    }
+
+    PuzzleRater::rateBatch(sets, ratings, threadCount);
+    for (size_t index = 0; index < ratings.size(); index++) {
+      outFile << PuzzleRater::ratingToString(ratings[index]);
+    }
+    rated += sets.size();
+  }
+  outFile.close();
+
+  if (readStatus == BAD_SET) {
+    cout << "Stopped at set " << rated + 1 << ", which is not a valid set.\n";
+    return EXIT_FAILURE;
+  }
+
+  cout << "Rated " << rated << " sets." << endl;
+  return 0;
+}
+
+
+
+/*
+ * Name:        runDifficultyMode
+ * Prototype:   int runDifficultyMode(int argc, char * argv[]);
+ * Description: This function drives producing sets within a range of
+ *                difficulty.
+ * Parameters:
+ *    argc      -Num of parameters, should be 6 or 7.
+ *    argv[2]   -The lowest difficulty to keep.
+ *    argv[3]   -The highest difficulty to keep.
+ *    argv[4]   -How many unique sets to produce.
+ *    argv[5]   -The file to write the sets to.
+ *    argv[6]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runDifficultyMode(int argc, char * argv[]) {
+
+  double lowest = 0, highest = 0;
+  long long count = 0, produced = 0;
+  int threadCount = 1;
+  ofstream outFile;
+
+  if (argc != NUM_OF_DIFFICULTY_ARGS && argc != NUM_OF_DIFFICULTY_ARGS + 1) {
+    cout << RATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    lowest = stod(argv[2], nullptr);
+    highest = stod(argv[3], nullptr);
+    count = stoll(argv[4], nullptr);
+    threadCount = threadsToUse(argc, argv, NUM_OF_DIFFICULTY_ARGS);
+    if (count < 0 || lowest > highest) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << RATE_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << RATE_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  outFile.open(argv[5], ios::out);
+  if (!outFile) {
+    cout << "Could not open " << argv[5] << " for writing.\n";
+    return EXIT_FAILURE;
+  }
+
+  PuzzlePipeline pipeline(threadCount);
+  pipeline.setDifficultyRange(lowest, highest);
+  produced = pipeline.produce(count, outFile);
+  outFile.close();
+
+  cout << "Wrote " << produced << " unique sets rated between " << lowest
+      << " and " << highest << " to " << argv[5] << "." << endl;
+
+  if (produced < count) {
+    cout << "Stopped after " << STALL_ATTEMPTS << " sets in a row were " \
+        "turned down, " << count - produced << " short. The range may be " \
+        "too narrow.\n";
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
+
+
+
+/*
+ * Name:        runDaemonMode
+ * Prototype:   int runDaemonMode(int argc, char * argv[]);
+ * Description: This function drives the solve daemon.
+ * Parameters:
+ *    argc      -Num of parameters, should be 3 or 4.
+ *    argv[2]   -Where to create the daemon's socket.
+ *    argv[3]   -Optionally, the number of worker threads.
+ * Return:      success or failure of execution
+ */
+int runDaemonMode(int argc, char * argv[]) {
+
+  int threadCount = 1;
+
+  if (argc != NUM_OF_DAEMON_ARGS && argc != NUM_OF_DAEMON_ARGS + 1) {
+    cout << DAEMON_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    threadCount = threadsToUse(argc, argv, NUM_OF_DAEMON_ARGS);
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << DAEMON_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  if (!HexPieces().loadTheTemplates()) {
+    cout << TEMPLATE_ERR;
+    return EXIT_FAILURE;
+  }
+
+  PuzzleDaemon daemon(threadCount);
+  if (!daemon.serve(argv[2])) {
+    cout << "Could not listen on " << argv[2] << ". If something else " \
+        "is there, or another daemon is using it, pick another path.\n";
+    return EXIT_FAILURE;
+  }
+
+  cout << "Daemon latency: " << daemon.latencyReport() << flush;
+  return 0;
+}
+
+
+
+/*
+ * Name:        runClientMode
+ * Prototype:   int runClientMode(int argc, char * argv[]);
+ * Description: This function drives sending requests to the daemon.
+ *                Answers go to stdout and the latencies seen by the client
+ *                go to stderr.
+ * Parameters:
+ *    argc      -Num of parameters, should be 4 or 5.
+ *    argv[2]   -The daemon's socket.
+ *    argv[3]   -What to ask for: solve, count, render, generate, stats or
+ *                 shutdown.
+ *    argv[4]   -The file of sets for solve, count and render, or how many
+ *                 sets to generate.
+ * Return:      success or failure of execution
+ */
+int runClientMode(int argc, char * argv[]) {
+
+  PuzzleClient client;
+  string request = argc > 3 ? argv[3] : "";
+  unsigned char op = 0, status = 0;
+  unsigned int count = 0, requestId = 0;
+  int possibleSet[ROWSIZE][COLSIZE] = {{0}};
+  string payload;
+  ifstream inFile;
+  bool answered = false;
+
+  if (request == "solve" || request == "count" || request == "render") {
+    op = request == "solve" ? OP_SOLVE : 
+        request == "count" ? OP_COUNT : OP_RENDER;
+  }
+  else if (request == "generate") {
+    op = OP_GENERATE;
+  }
+  else if (request == "stats" || request == "shutdown") {
+    op = request == "stats" ? OP_STATS : OP_SHUTDOWN;
+  }
+
+  if (!op || argc != NUM_OF_CLIENT_ARGS + (op <= OP_RENDER ? 1 : 0)) {
+    cout << CLIENT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    if (op == OP_GENERATE) {
+      count = (unsigned int)stoul(argv[4], nullptr);
+      if (count > MAX_GENERATE) {
+        throw 30;
+      }
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << CLIENT_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << CLIENT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  if (!client.connectTo(argv[2])) {
+    cout << "Could not connect to " << argv[2] << ".\n";
+    return EXIT_FAILURE;
+  }
+
+  if (op == OP_SOLVE || op == OP_COUNT || op == OP_RENDER) {
+    inFile.open(argv[4], ios::in);
+    answered = inFile && client.sendSets(op, inFile, cout);
+  }
+  else {
+    answered = client.sendRequest(op, count, possibleSet) &&
+        client.receiveResponse(requestId, status, payload);
+    if (answered) {
+      client.printResponse(op, status, payload, cout);
+    }
+  }
+
+  cerr << "Client latency: " << client.latencyReport();
+
+  if (!answered) {
+    cout << "The daemon did not answer every request.\n";
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
+
+
+
+/*
+ * Name:        runExportMode
+ * Prototype:   int runExportMode(int argc, char * argv[]);
+ * Description: This function drives exporting solve animations.
+ * Parameters:
+ *    argc      -Num of parameters, should be 4 to 7.
+ *    argv[2]   -How many puzzles to record.
+ *    argv[3]   -The directory to write the recordings to.
+ *    argv[4]   -Optionally, the format: cast or frames.
+ *    argv[5]   -Optionally, the duration of a frame (0-5s).
+ *    argv[6]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runExportMode(int argc, char * argv[]) {
+
+  long long count = 0, exported = 0;
+  int frameTime = ONE_SECOND, threadCount = 1;
+  string format = CAST_FORMAT;
+
+  if (argc < NUM_OF_EXPORT_ARGS || argc > NUM_OF_EXPORT_ARGS + 3) {
+    cout << EXPORT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    count = stoll(argv[2], nullptr);
+    if (argc > NUM_OF_EXPORT_ARGS) {
+      format = argv[NUM_OF_EXPORT_ARGS];
+    }
+    if (argc > NUM_OF_EXPORT_ARGS + 1) {
+      frameTime = (int)(stod(argv[NUM_OF_EXPORT_ARGS + 1], nullptr) * 
+          ONE_SECOND);
+    }
+    threadCount = threadsToUse(argc, argv, NUM_OF_EXPORT_ARGS + 2);
+    if (count < 0 || (format != CAST_FORMAT && format != FRAMES_FORMAT) ||
+        frameTime > (5 * ONE_SECOND) || frameTime < 0) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << EXPORT_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << EXPORT_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  PuzzleExporter exporter(format, frameTime, threadCount);
+  exported = exporter.exportPuzzles(count, argv[3]);
+  if (exported < 0) {
+    cout << TEMPLATE_ERR;
+    return EXIT_FAILURE;
+  }
+
+  cout << "Exported " << exported << " recordings to " << argv[3] << "." 
+      << endl;
+
+  if (exported < count) {
+    cout << "Stopped after " << STALL_ATTEMPTS << " sets in a row were " \
+        "turned down, " << count - exported << " short.\n";
+    return EXIT_FAILURE;
+  }
+
+  return 0;
+}
+
+
+
+/*
+ * Name:        runOrderingMode
+ * Prototype:   int runOrderingMode(int argc, char * argv[]);
+ * Description: This function drives comparing the piece ordering modes.
+ * Parameters:
+ *    argc      -Num of parameters, should be 3 or 4.
+ *    argv[2]   -How many sets to sample.
+ *    argv[3]   -Optionally, the number of threads to use.
+ * Return:      success or failure of execution
+ */
+int runOrderingMode(int argc, char * argv[]) {
+
+  long long samples = 0;
+  int threadCount = 1;
+
+  if (argc != NUM_OF_ORDERING_ARGS && argc != NUM_OF_ORDERING_ARGS + 1) {
+    cout << ORDERING_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  try {
+    samples = stoll(argv[2], nullptr);
+    threadCount = threadsToUse(argc, argv, NUM_OF_ORDERING_ARGS);
+    if (samples < 0) {
+      throw 30;
+    }
+  }
+  catch (const exception & e) {
+    cout << USAGE_ERR << ORDERING_USAGE;
+    return EXIT_FAILURE;
+  }
+  catch (int e) {
+    cout << USAGE_ERR << ORDERING_USAGE;
+    return EXIT_FAILURE;
+  }
+
+  PuzzleOrderings orderings(threadCount);
+  orderings.compare(samples, cout);
+  return 0;
+}
+
+
+
 /*
  * Name:        main 
  * Prototype:   int main(); 
@@ -17,6 +670,7 @@ using namespace std;
  * Parameters:  
  *    argc      -Num of parameters, should be 1. 
  *    argv[1]   -represents the duration of a frame (0-5s).
+ *    argv[2]   -optionally, the order to try pieces in.
  * Return:      success or failure of execution 
  */
 int main(int argc, char * argv[]) {
@@ -26,7 +680,38 @@ int main(int argc, char * argv[]) {
   int originalSet[ROWSIZE][COLSIZE] = {{0}};
   int attempts = 1, showSteps = 0;
  
-  if (argc != NUM_OF_ARGS) {
+  if (argc > 1 && argv[1] == COUNT_FLAG) {
+    return runCountMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == SHARD_FLAG) {
+    return runShardMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == MERGE_FLAG) {
+    return runMergeMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == ESTIMATE_FLAG) {
+    return runEstimateMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == RATE_FLAG) {
+    return runRateMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == DIFFICULTY_FLAG) {
+    return runDifficultyMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == DAEMON_FLAG) {
+    return runDaemonMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == CLIENT_FLAG) {
+    return runClientMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == EXPORT_FLAG) {
+    return runExportMode(argc, argv);
+  }
+  if (argc > 1 && argv[1] == ORDERING_FLAG) {
+    return runOrderingMode(argc, argv);
+  }
+
+  if (argc != NUM_OF_ARGS && argc != NUM_OF_ARGS + 1) {
     cout << USAGE_PROMPT; 
     return EXIT_FAILURE;
   }
@@ -37,6 +722,18 @@ int main(int argc, char * argv[]) {
         myPuzzle.frameTime < 0) {
       throw 30;
     }
+
+    if (argc > NUM_OF_ARGS) {
+      myPuzzle.orderingMode = -1;
+      for (int mode = 0; mode < NUM_OF_ORDERINGS; mode++) {
+        if (argv[NUM_OF_ARGS] == ORDERING_NAMES[mode]) {
+          myPuzzle.orderingMode = mode;
+        }
+      }
+      if (myPuzzle.orderingMode < 0) {
+        throw 30;
+      }
+    }
   }
   catch (exception e) {
     cout << USAGE_ERR << USAGE_PROMPT;
@@ -47,6 +744,11 @@ int main(int argc, char * argv[]) {
     return EXIT_FAILURE;
   }
 
+  if (!myPuzzle.loadTheTemplates()) {
+    cout << TEMPLATE_ERR;
+    return EXIT_FAILURE;
+  }
+
   myPuzzle.generateARandomSet(possibleSet); 
   while (!myPuzzle.isTheRandomSetSolvable(possibleSet, 0)){
     myPuzzle.generateARandomSet(possibleSet);
@@ -0,0 +1,249 @@
+/* Author:      Vincent Sevilla
+ * Filename:    HexTests.cpp
+ * Description: A small test driver for the parts of the program that can
+ *                be checked without running a whole mode: set ranking,
+ *                canonical keys, merging census shards and the estimator's
+ *                interval. It prints every failed check and exits with
+ *                failure if there were any.
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "HexPieces.h"
+#include "PieceSets.h"
+#include "PuzzleCensus.h"
+#include "PuzzleEstimator.h"
+
+using namespace std;
+
+const long long SET_CHECKS = 1000;
+const long long RANDOM_CHECKS = 20000;
+const double TOLERANCE = 1e-4;
+
+static int failures = 0;
+
+
+/*
+ * Name:        check
+ * Prototype:   check(bool passed, const string & what);
+ * Description: This function records one check, writing out what was
+ *                being checked if it failed.
+ * Parameters:
+ *    passed      - Whether the check passed
+ *    what        - What was being checked
+ */
+static void check(bool passed, const string & what) {
+  if (!passed) {
+    cout << "FAILED: " << what << "\n";
+    failures++;
+  }
+}
+
+
+
+/*
+ * Name:        testSetRanks
+ * Prototype:   testSetRanks();
+ * Description: This function checks that ranking and unranking agree over
+ *                the whole range of ranks: the smallest and largest sets
+ *                get ranks 0 and NUM_OF_SETS - 1, and ranks spread evenly
+ *                across the range, and random ones, unrank to valid sets
+ *                that rank back to the same number.
+ */
+static void testSetRanks() {
+
+  mt19937_64 generator(1);
+  uniform_int_distribution<long long> ranks(0, NUM_OF_SETS - 1);
+  int puzzlePieces[ROWSIZE][COLSIZE];
+  long long rank = 0;
+  bool roundTrips = true;
+
+  check(NUM_OF_SETS == 59487568920LL, "NUM_OF_SETS is 120 choose 7");
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    pieceFromClass(tileNumber, puzzlePieces[tileNumber]);
+  }
+  check(rankASet(puzzlePieces) == 0, "the first set has rank 0");
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    pieceFromClass(NUM_OF_CLASSES - ROWSIZE + tileNumber, 
+        puzzlePieces[tileNumber]);
+  }
+  check(rankASet(puzzlePieces) == NUM_OF_SETS - 1, 
+      "the last set has rank NUM_OF_SETS - 1");
+
+  for (long long sample = 0; sample <= SET_CHECKS + RANDOM_CHECKS; 
+      sample++) {
+    rank = sample <= SET_CHECKS 
+        ? sample * (NUM_OF_SETS - 1) / SET_CHECKS : ranks(generator);
+    unrankASet(rank, puzzlePieces);
+    roundTrips = roundTrips && isAValidSet(puzzlePieces) && 
+        rankASet(puzzlePieces) == rank;
+  }
+  check(roundTrips, "ranks unrank to valid sets that rank back");
+}
+
+
+
+/*
+ * Name:        testCanonicalKey
+ * Prototype:   testCanonicalKey();
+ * Description: This function checks that turning the pieces of a set or
+ *                putting them in another order does not change its key,
+ *                and that sets with different ranks get different keys.
+ */
+static void testCanonicalKey() {
+
+  mt19937_64 generator(2);
+  uniform_int_distribution<int> turns(0, COLSIZE - 1);
+  int puzzlePieces[ROWSIZE][COLSIZE], moved[ROWSIZE][COLSIZE];
+  int order[ROWSIZE];
+  unsigned long long key = 0;
+  bool sameKey = true, differentKeys = true;
+
+  for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+    order[tileNumber] = tileNumber;
+  }
+
+  for (long long sample = 0; sample < RANDOM_CHECKS; sample++) {
+    sampleASet(generator, puzzlePieces);
+    key = canonicalKey(puzzlePieces);
+
+    shuffle(order, order + ROWSIZE, generator);
+    for (int tileNumber = 0; tileNumber < ROWSIZE; tileNumber++) {
+      rotate_copy(puzzlePieces[order[tileNumber]], 
+          puzzlePieces[order[tileNumber]] + turns(generator),
+          puzzlePieces[order[tileNumber]] + COLSIZE, moved[tileNumber]);
+    }
+    sameKey = sameKey && canonicalKey(moved) == key;
+
+    unrankASet((rankASet(puzzlePieces) + 1) % NUM_OF_SETS, moved);
+    differentKeys = differentKeys && canonicalKey(moved) != key;
+  }
+
+  check(sameKey, "turned and reordered pieces keep the set's key");
+  check(differentKeys, "neighbouring ranks get different keys");
+}
+
+
+
+/*
+ * Name:        testMergeResults
+ * Prototype:   testMergeResults();
+ * Description: This function checks that shards merge back into the whole
+ *                range in any order, and that gaps, overlaps and an empty
+ *                list are turned down.
+ */
+static void testMergeResults() {
+
+  const int shardCount = 7;
+  mt19937_64 generator(3);
+  vector<CensusResult> results, broken;
+  CensusResult result, merged;
+
+  for (int shard = 0; shard < shardCount; shard++) {
+    PuzzleCensus::shardRange(shard, shardCount, result.first, result.last);
+    result.sets = result.last - result.first;
+    result.solvable = shard;
+    results.push_back(result);
+  }
+  shuffle(results.begin(), results.end(), generator);
+
+  check(PuzzleCensus::mergeResults(results, merged) && merged.first == 0 &&
+      merged.last == NUM_OF_SETS && merged.sets == NUM_OF_SETS &&
+      merged.solvable == shardCount * (shardCount - 1) / 2, 
+      "shards in any order merge into the whole range");
+
+  broken = results;
+  broken.pop_back();
+  check(!PuzzleCensus::mergeResults(broken, merged) || merged.first != 0 ||
+      merged.last != NUM_OF_SETS, "a missing shard is not the whole range");
+
+  /*break the shards in the middle of the range, not at either end*/
+  sort(results.begin(), results.end(), 
+      [](const CensusResult & a, const CensusResult & b) {
+        return a.first < b.first;
+      });
+
+  broken = results;
+  broken.erase(broken.begin() + shardCount / 2);
+  check(!PuzzleCensus::mergeResults(broken, merged), 
+      "a gap between shards is turned down");
+
+  broken = results;
+  broken.push_back(results[shardCount / 2]);
+  check(!PuzzleCensus::mergeResults(broken, merged), 
+      "a repeated shard is turned down");
+
+  broken = results;
+  broken[shardCount / 2].last++;
+  broken[shardCount / 2].sets++;
+  check(!PuzzleCensus::mergeResults(broken, merged), 
+      "overlapping shards are turned down");
+
+  broken.clear();
+  check(!PuzzleCensus::mergeResults(broken, merged), 
+      "an empty list is turned down");
+}
+
+
+
+/*
+ * Name:        testInterval
+ * Prototype:   testInterval();
+ * Description: This function checks the z scores of common confidence
+ *                levels and the Wilson interval against worked values.
+ */
+static void testInterval() {
+
+  EstimateResult result;
+
+  check(fabs(PuzzleEstimator::zScore(0.95) - 1.959964) < TOLERANCE, 
+      "z of 0.95 is 1.96");
+  check(fabs(PuzzleEstimator::zScore(0.99) - 2.575829) < TOLERANCE, 
+      "z of 0.99 is 2.576");
+
+  result = PuzzleEstimator::interval(100, 50, 1.96);
+  check(fabs(result.estimate - 0.5) < TOLERANCE && 
+      fabs(result.low - 0.403832) < TOLERANCE &&
+      fabs(result.high - 0.596168) < TOLERANCE, 
+      "50 of 100 gives [0.4038, 0.5962]");
+
+  result = PuzzleEstimator::interval(100, 0, 1.96);
+  check(result.estimate == 0 && fabs(result.low) < TOLERANCE && 
+      fabs(result.high - 0.036994) < TOLERANCE, 
+      "0 of 100 gives [0, 0.0370]");
+
+  result = PuzzleEstimator::interval(0, 0, 1.96);
+  check(result.low == 0 && result.high == 1, 
+      "no samples gives the whole of [0, 1]");
+}
+
+
+
+/*
+ * Name:        main
+ * Prototype:   int main();
+ * Description: Runs every test.
+ * Return:      success if every check passed, failure if not
+ */
+int main() {
+
+  testSetRanks();
+  testCanonicalKey();
+  testMergeResults();
+  testInterval();
+
+  if (failures) {
+    cout << failures << " checks failed." << endl;
+    return EXIT_FAILURE;
+  }
+
+  cout << "All checks passed." << endl;
+  return 0;
+}